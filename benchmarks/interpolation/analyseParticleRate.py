@@ -0,0 +1,27 @@
+# Throughput of the particle operators (interpolation, push, projection)
+# usage : python analyseParticleRate.py <simulation directory> <smilei standard output> [number of MPI processes]
+import sys
+import happi
+
+S = happi.Open(sys.argv[1])
+
+# number of particles pushed during the time loop (first iteration excluded, as in the timers)
+npart = 0.
+for species in S.namelist.Species:
+    ntot = S.Scalar("Ntot_"+species.name).getData()
+    npart += sum(ntot[1:])
+
+# time of the "Particles" timer, averaged per MPI process
+tparticles = None
+for line in open(sys.argv[2]):
+    words = line.split()
+    if len(words)>=2 and words[0]=="Particles":
+        tparticles = float(words[1])
+if tparticles is None:
+    sys.exit("No Particles timer found in "+sys.argv[2])
+
+nproc = int(sys.argv[3]) if len(sys.argv)>3 else 1
+print("interpolation_order = %d" % S.namelist.Main.interpolation_order)
+print("particles           = %g" % npart)
+print("Particles timer     = %g s" % tparticles)
+print("rate                = %g particles/s per MPI process" % (npart/nproc/tparticles))
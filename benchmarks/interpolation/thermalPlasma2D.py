@@ -0,0 +1,45 @@
+# ---------------------------------------------
+# SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ---------------------------------------------
+# Interpolation throughput benchmark : uniform thermal plasma, no diagnostic
+# but the scalars, to be analysed with analyseParticleRate.py
+# Set interpolation_order to 2 or 4
+
+import math as m
+
+interpolation_order = 2
+
+Te   = 0.01
+Lde  = m.sqrt(Te)
+dx   = 0.5*Lde
+dt   = 0.95*dx/m.sqrt(2.)
+nppc = 256
+
+Main(
+    geometry = "2Dcartesian",
+    interpolation_order = interpolation_order,
+    cell_length  = [dx,dx],
+    grid_length  = [256.*dx,256.*dx],
+    number_of_patches = [8,8],
+    timestep = dt,
+    simulation_time = 100*dt,
+    EM_boundary_conditions = [ ["periodic"] ],
+    random_seed = smilei_mpi_rank,
+    print_every = 10
+)
+
+Species(
+    name = "electron",
+    position_initialization = "random",
+    momentum_initialization = "mj",
+    particles_per_cell = nppc,
+    mass = 1.0,
+    charge = -1.0,
+    number_density = 1.,
+    temperature = [Te],
+    pusher = "boris",
+    boundary_conditions = [ ["periodic"] ],
+    cell_sort_every = 10,
+)
+
+DiagScalar(every = 1)
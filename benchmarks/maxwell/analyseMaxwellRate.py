@@ -0,0 +1,35 @@
+# Throughput of the Maxwell solvers (saveMagneticFields, Maxwell-Ampere, Maxwell-Faraday)
+# usage : python analyseMaxwellRate.py <simulation directory> <smilei standard output> [number of MPI processes]
+import sys
+import happi
+
+S = happi.Open(sys.argv[1])
+Main = S.namelist.Main
+
+# cells of the patch arrays, ghost cells included (dual size along each direction)
+ncells = 1.
+for d in range(3):
+    n_space = int(round(Main.grid_length[d]/Main.cell_length[d])) // Main.number_of_patches[d]
+    ncells *= ( n_space + 2 + 2*Main.interpolation_order ) * Main.number_of_patches[d]
+
+# number of iterations, the first one excluded as in the timers
+niterations = int(round(Main.simulation_time/Main.timestep)) - 1
+
+# time of the "Maxwell" timer, averaged per MPI process
+tmaxwell = None
+for line in open(sys.argv[2]):
+    words = line.split()
+    if len(words)>=2 and words[0]=="Maxwell":
+        tmaxwell = float(words[1])
+if tmaxwell is None:
+    sys.exit("No Maxwell timer found in "+sys.argv[2])
+
+# doubles read and written per cell : saveMagneticFields 3+3, Maxwell-Ampere 9+3, Maxwell-Faraday 6+3
+bytes_per_cell = 27*8
+
+nproc = int(sys.argv[3]) if len(sys.argv)>3 else 1
+rate = ncells*niterations/nproc/tmaxwell
+print("cells (with ghosts) = %g" % ncells)
+print("Maxwell timer       = %g s" % tmaxwell)
+print("rate                = %g cells/s per MPI process" % rate)
+print("bandwidth           = %g GB/s per MPI process" % (rate*bytes_per_cell/1e9))
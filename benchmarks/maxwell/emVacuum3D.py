@@ -0,0 +1,41 @@
+# ---------------------------------------------
+# SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ---------------------------------------------
+# Maxwell solver throughput benchmark : laser in vacuum, no diagnostic
+# but the scalars, to be analysed with analyseMaxwellRate.py
+# Set cells_per_patch to the patch size to be studied, and fused to compare
+# the fused field step with the separate solvers
+
+import math as m
+
+cells_per_patch = 16
+fused = False
+
+l0   = 2.*m.pi
+resx = 16.
+dx   = l0/resx
+dt   = 0.95*dx/m.sqrt(3.)
+npatch = 4
+L    = npatch*cells_per_patch*dx
+
+Main(
+    geometry = "3Dcartesian",
+    interpolation_order = 2,
+    cell_length  = [dx,dx,dx],
+    grid_length  = [L,L,L],
+    number_of_patches = [npatch,npatch,npatch],
+    timestep = dt,
+    simulation_time = 200*dt,
+    EM_boundary_conditions = [ ["silver-muller"] ],
+    fused_field_step = fused,
+    print_every = 20
+)
+
+LaserGaussian3D(
+    a0      = 1.,
+    omega   = 1.,
+    focus   = [0.5*L, 0.5*L, 0.5*L],
+    waist   = 0.25*L,
+)
+
+DiagScalar(every = 20)
@@ -0,0 +1,70 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Differential checkpoints : the ions are frozen during the first half of the run, so that
+# their data goes to the static file, then move, so that it must be pruned from it.
+
+import math
+# resolution
+resx = 100.0
+rest = 110.0
+# plasma length
+L = 2.0*math.pi
+
+Main(
+    geometry = "1Dcartesian",
+    interpolation_order = 2,
+    
+    cell_length = [L/resx],
+    grid_length  = [4.0*L],
+    
+    number_of_patches = [ 8 ],
+    
+    timestep = L/rest,
+    simulation_time = 10.0 * math.pi,
+    
+    clrw = 1,
+    
+    EM_boundary_conditions = [ ['silver-muller'] ],
+    
+    random_seed = smilei_mpi_rank
+)
+
+Species(
+	name = "ion",
+	position_initialization = "random",
+	momentum_initialization = "cold",
+	particles_per_cell = 50,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = trapezoidal(1., xvacuum=L, xplateau=L),
+	time_frozen = 5.0 * math.pi,
+	boundary_conditions = [
+		["stop", "stop"],
+	],
+)
+
+Species(
+	name = "eon",
+	position_initialization = "random",
+	momentum_initialization = "mj",
+	temperature = [0.001],
+	particles_per_cell = 50,
+	mass = 1.0,
+	charge = -1.0,
+	number_density = trapezoidal(1., xvacuum=L, xplateau=L),
+	boundary_conditions = [
+		["stop", "stop"],
+	],
+)
+
+Checkpoints(
+	dump_step = 20,
+	exit_after_dump = False,
+	keep_n_dumps = 2,
+	differential = True,
+)
+
+DiagScalar(
+	every = 1
+)
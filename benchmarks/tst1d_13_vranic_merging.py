@@ -0,0 +1,68 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Macro-particle merging (Vranic method) : thermal electrons with many macro-particles per
+# cell, merged every 10 timesteps down to about merge_min_particles_per_cell.
+
+import math
+
+Main(
+    geometry = "1Dcartesian",
+    
+    interpolation_order = 2,
+    
+    cell_length = [0.1],
+    grid_length  = [12.8],
+    
+    number_of_patches = [ 4 ],
+    
+    timestep = 0.05,
+    simulation_time = 10.,
+    
+    EM_boundary_conditions = [ ['periodic'] ],
+    
+    random_seed = 0
+)
+
+Species(
+	name = "eon",
+	position_initialization = "random",
+	momentum_initialization = "mj",
+	temperature = [0.05],
+	particles_per_cell = 128,
+	mass = 1.0,
+	charge = -1.0,
+	number_density = 1.,
+	boundary_conditions = [
+		["periodic", "periodic"],
+	],
+	merging_method = "vranic",
+	merge_every = 10,
+	merge_min_particles_per_cell = 32,
+	merge_packet_size = 4,
+	merge_momentum_cell_size = [4,4,4],
+)
+
+Species(
+	name = "ion",
+	position_initialization = "random",
+	momentum_initialization = "cold",
+	particles_per_cell = 32,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = 1.,
+	boundary_conditions = [
+		["periodic", "periodic"],
+	],
+)
+
+DiagScalar(
+	every = 10
+)
+
+DiagParticleBinning(
+	deposited_quantity = "weight",
+	every = 10,
+	species = ["eon"],
+	axes = [ ["x", 0., 12.8, 1] ]
+)
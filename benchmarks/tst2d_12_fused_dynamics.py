@@ -0,0 +1,65 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Fused dynamics : a laser going through an underdense plasma, the electrons pushed with
+# the boris pusher and the ions with the vay pusher, both by chunks of particles.
+
+import math
+
+l0 = 2.0*math.pi
+resx = 16.
+dx = l0/resx
+dt = 0.95*dx/math.sqrt(2.)
+Lsim = [128*dx, 64*dx]
+
+Main(
+    geometry = "2Dcartesian",
+    
+    interpolation_order = 2,
+    
+    cell_length = [dx, dx],
+    grid_length  = Lsim,
+    
+    number_of_patches = [ 8, 4 ],
+    
+    timestep = dt,
+    simulation_time = 200*dt,
+    
+    EM_boundary_conditions = [ ['silver-muller'], ['periodic'] ],
+    
+    random_seed = smilei_mpi_rank
+)
+
+LaserGaussian2D(
+    a0 = 2.,
+    omega = 1.,
+    focus = [0.5*Lsim[0], 0.5*Lsim[1]],
+    waist = 2.*l0,
+)
+
+for name, mass, charge, pusher in [("eon", 1., -1., "boris"), ("ion", 100., 1., "vay")]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "mj",
+		temperature = [0.001],
+		particles_per_cell = 4,
+		mass = mass,
+		charge = charge,
+		pusher = pusher,
+		number_density = trapezoidal(0.1, xvacuum=0.25*Lsim[0], xplateau=0.5*Lsim[0]),
+		boundary_conditions = [
+			["remove", "remove"],
+			["periodic", "periodic"],
+		],
+		fused_dynamics = True,
+	)
+
+DiagScalar(
+	every = 10
+)
+
+DiagFields(
+	every = 100,
+	fields = ['Ex','Ey','Bz','Rho_eon']
+)
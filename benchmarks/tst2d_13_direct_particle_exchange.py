@@ -0,0 +1,49 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Direct particle exchange : hot drifting plasma on many small patches, so that many
+# particles leave their patch through an edge or a corner. Only scalar diagnostics, to be
+# run on several MPI processes.
+
+import math
+
+Main(
+    geometry = "2Dcartesian",
+    
+    interpolation_order = 2,
+    
+    cell_length = [0.1, 0.1],
+    grid_length  = [6.4, 6.4],
+    
+    number_of_patches = [ 8, 8 ],
+    
+    timestep = 0.05,
+    simulation_time = 10.,
+    
+    EM_boundary_conditions = [ ['periodic'], ['periodic'] ],
+    
+    direct_particle_exchange = True,
+    
+    random_seed = 0
+)
+
+for name, mass, charge in [("eon", 1., -1.), ("ion", 10., 1.)]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "mj",
+		temperature = [0.2],
+		mean_velocity = [0.3, 0.3, 0.],
+		particles_per_cell = 4,
+		mass = mass,
+		charge = charge,
+		number_density = 1.,
+		boundary_conditions = [
+			["periodic", "periodic"],
+			["periodic", "periodic"],
+		],
+	)
+
+DiagScalar(
+	every = 10
+)
@@ -0,0 +1,49 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Ghost cells aggregated per neighbor MPI process, read from the shared field arenas of the
+# MPI processes of the node : two counter-streaming thermal plasmas crossing all the patches.
+
+import math
+
+Main(
+    geometry = "2Dcartesian",
+    interpolation_order = 2,
+    
+    cell_length = [0.1, 0.1],
+    grid_length  = [6.4, 6.4],
+    
+    number_of_patches = [ 4, 4 ],
+    
+    timestep = 0.05,
+    simulation_time = 10.,
+    
+    EM_boundary_conditions = [ ['periodic'], ['periodic'] ],
+    
+    random_seed = 0,
+    
+    aggregate_ghost_messages = True,
+    shared_memory_exchanges = True,
+    field_arena = True,
+)
+
+for name, mass, charge, drift in [("eon1", 1., -1., 0.1), ("eon2", 1., -1., -0.1), ("ion", 100., 1., 0.)]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "mj",
+		temperature = [0.01],
+		mean_velocity = [drift, 0.5*drift, 0.],
+		particles_per_cell = 4,
+		mass = mass,
+		charge = charge,
+		number_density = 0.5 if charge<0. else 1.,
+		boundary_conditions = [
+			["periodic", "periodic"],
+			["periodic", "periodic"],
+		],
+	)
+
+DiagScalar(
+	every = 10
+)
@@ -0,0 +1,81 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Binomial current filter with a single exchange of the ghost cells for all the passes :
+# a density perturbation in a warm periodic plasma, drifting obliquely.
+# At interpolation order 4, the oversize is already as large as the number of passes : it is
+# not changed by single_exchange, and the results must be identical to those of the exchange
+# after each pass.
+
+import math
+
+l0 = 2.0*math.pi
+dx = l0/16.
+dt = 0.95*dx/math.sqrt(2.)
+Lsim = [128*dx, 64*dx]
+
+Main(
+    geometry = "2Dcartesian",
+    
+    interpolation_order = 4,
+    
+    cell_length = [dx, dx],
+    grid_length  = Lsim,
+    
+    number_of_patches = [ 8, 4 ],
+    
+    timestep = dt,
+    simulation_time = 160*dt,
+    
+    EM_boundary_conditions = [ ['periodic'], ['periodic'] ],
+    
+    random_seed = smilei_mpi_rank
+)
+
+def perturbation(x, y):
+	return 0.2*( 1. + 0.3*math.cos(2.*math.pi*x/Lsim[0]) * math.cos(2.*math.pi*y/Lsim[1]) )
+
+Species(
+	name = "eon",
+	position_initialization = "random",
+	momentum_initialization = "mj",
+	mean_velocity = [0.1, 0.05, 0.],
+	temperature = [0.001],
+	particles_per_cell = 8,
+	mass = 1.0,
+	charge = -1.0,
+	number_density = perturbation,
+	boundary_conditions = [
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+
+Species(
+	name = "ion",
+	position_initialization = "eon",
+	momentum_initialization = "cold",
+	particles_per_cell = 8,
+	mass = 1836.0,
+	charge = 1.0,
+	number_density = perturbation,
+	boundary_conditions = [
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+
+CurrentFilter(
+	model = "binomial",
+	passes = 3,
+	single_exchange = True,
+)
+
+DiagScalar(
+	every = 10
+)
+
+DiagFields(
+	every = 80,
+	fields = ['Ex','Ey','Bz','Jx','Jy']
+)
@@ -0,0 +1,48 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Laser in vacuum, with patches long enough along y and z to be swept by the Yee solvers
+# in several cache blocks, the last one incomplete.
+
+import math
+
+l0 = 2.0*math.pi
+resx = 16.
+dx = l0/resx
+dt = 0.95*dx/math.sqrt(3.)
+Lsim = [16*dx, 96*dx, 64*dx]
+
+Main(
+    geometry = "3Dcartesian",
+    
+    interpolation_order = 2,
+    
+    cell_length = [dx, dx, dx],
+    grid_length  = Lsim,
+    
+    number_of_patches = [ 2, 1, 1 ],
+    
+    timestep = dt,
+    simulation_time = 60*dt,
+    
+    EM_boundary_conditions = [ ['silver-muller'] ],
+    
+    random_seed = smilei_mpi_rank
+)
+
+LaserGaussian3D(
+    a0              = 1.,
+    omega           = 1.,
+    focus           = [0.5*Lsim[0], 0.4*Lsim[1], 0.6*Lsim[2]],
+    waist           = l0,
+    incidence_angle = [0.2, 0.1],
+)
+
+DiagScalar(
+    every = 10
+)
+
+DiagFields(
+    every = 60,
+    fields = ['Ex','Ey','Ez','Bx','By','Bz']
+)
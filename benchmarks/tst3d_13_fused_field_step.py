@@ -0,0 +1,65 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Fused field step : a laser hitting a cold plasma slab, so that the currents enter the
+# Maxwell-Ampere equation, with a silver-muller boundary and periodic transverse boundaries.
+
+import math
+
+l0 = 2.0*math.pi
+resx = 8.
+dx = l0/resx
+dt = 0.95*dx/math.sqrt(3.)
+Lsim = [64*dx, 16*dx, 16*dx]
+
+Main(
+    geometry = "3Dcartesian",
+    
+    interpolation_order = 2,
+    
+    cell_length = [dx, dx, dx],
+    grid_length  = Lsim,
+    
+    number_of_patches = [ 4, 2, 2 ],
+    
+    timestep = dt,
+    simulation_time = 80*dt,
+    
+    EM_boundary_conditions = [ ['silver-muller'], ['periodic'], ['periodic'] ],
+    
+    fused_field_step = True,
+    
+    random_seed = smilei_mpi_rank
+)
+
+LaserPlanar1D(
+    box_side = "xmin",
+    a0 = 1.,
+    omega = 1.,
+    ellipticity = 0.,
+    time_envelope = tconstant(),
+)
+
+Species(
+	name = "eon",
+	position_initialization = "regular",
+	momentum_initialization = "cold",
+	particles_per_cell = 8,
+	mass = 1.0,
+	charge = -1.0,
+	number_density = trapezoidal(0.5, xvacuum=0.5*Lsim[0], xplateau=0.25*Lsim[0]),
+	boundary_conditions = [
+		["remove", "remove"],
+		["periodic", "periodic"],
+		["periodic", "periodic"],
+	],
+)
+
+DiagScalar(
+	every = 10
+)
+
+DiagFields(
+	every = 40,
+	fields = ['Ex','Ey','Ez','Bx','By','Bz','Jx','Jy','Rho_eon']
+)
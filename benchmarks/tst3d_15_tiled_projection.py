@@ -0,0 +1,54 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+# Tiled projection : drifting thermal plasma, sorted by cell at each timestep so that the
+# currents of the particles of a cell are accumulated together.
+
+import math
+
+Main(
+    geometry = "3Dcartesian",
+    
+    interpolation_order = 2,
+    
+    cell_length = [0.2, 0.2, 0.2],
+    grid_length  = [3.2, 3.2, 3.2],
+    
+    number_of_patches = [ 2, 2, 2 ],
+    
+    timestep = 0.1,
+    simulation_time = 6.,
+    
+    EM_boundary_conditions = [ ['periodic'] ],
+    
+    random_seed = 0
+)
+
+for name, mass, charge in [("eon", 1., -1.), ("ion", 25., 1.)]:
+	Species(
+		name = name,
+		position_initialization = "random",
+		momentum_initialization = "mj",
+		temperature = [0.05],
+		mean_velocity = [0.2, 0., 0.1],
+		particles_per_cell = 16,
+		mass = mass,
+		charge = charge,
+		number_density = 1.,
+		boundary_conditions = [
+			["periodic", "periodic"],
+			["periodic", "periodic"],
+			["periodic", "periodic"],
+		],
+		cell_sort_every = 1,
+		tiled_projection = True,
+	)
+
+DiagScalar(
+	every = 5
+)
+
+DiagFields(
+	every = 30,
+	fields = ['Jx','Jy','Jz','Rho']
+)
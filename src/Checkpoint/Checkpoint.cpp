@@ -9,6 +9,10 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <cstring>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 
 #include <mpi.h>
 
@@ -44,7 +48,11 @@ keep_n_dumps(2),
 keep_n_dumps_max(10000),
 dump_deflate(0),
 dump_request(smpi->getSize()),
-file_grouping(0)
+file_grouping(0),
+differential(false),
+static_fid(-1),
+static_unlinked(0),
+restart_lapl(H5P_DEFAULT)
 {
     
     if( PyTools::nComponents("Checkpoints") > 0 ) {
@@ -75,6 +83,8 @@ file_grouping(0)
             if( file_grouping > (unsigned int)(smpi->getSize()) ) file_grouping = smpi->getSize();
             MESSAGE(1,"Code will group checkpoint files by "<< file_grouping);
         }
+        
+        PyTools::extract("differential", differential, "Checkpoints");
 
         if( params.restart ) {
             std::vector<std::string> restart_files;
@@ -120,6 +130,9 @@ file_grouping(0)
             message << " keeping "<< keep_n_dumps << " dumps at maximum";
             MESSAGE(1,message.str());
         }
+        if (differential) {
+            MESSAGE(1,"Data unchanged between two dumps will be written once in static files");
+        }
     }
         
     // registering signal handler
@@ -186,6 +199,15 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
     hid_t fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
     dump_number++;
     
+    // The static file sits next to the dump files, and is linked by its name relative to their directory
+    string dumpDir = dumpName.substr(0, dumpName.find_last_of(PATH_SEPARATOR)+1);
+    if (differential) {
+        ostringstream nameStatic("");
+        nameStatic << "static-" << setfill('0') << setw(10) << smpi->getRank() << ".h5" ;
+        static_file = nameStatic.str();
+        openStaticFile( dumpDir, dumpName.substr(dumpDir.size()), num_dump );
+    }
+    
 #ifdef  __DEBUG
     MESSAGEALL("Step " << itime << " : DUMP fields and particles " << dumpName);
 #else
@@ -262,6 +284,12 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
     
     H5Fclose( fid );
     
+    if (differential) {
+        pruneStaticFile( dumpDir + static_file );
+        last_checksum.swap( next_checksum );
+        next_checksum.clear();
+    }
+    
 }
 
 void Checkpoint::dumpPatch( ElectroMagn* EMfields, std::vector<Species*> vecSpecies, hid_t patch_gid )
@@ -352,44 +380,63 @@ void Checkpoint::dumpPatch( ElectroMagn* EMfields, std::vector<Species*> vecSpec
         ostringstream name("");
         name << setfill('0') << setw(2) << ispec;
         string groupName=Tools::merge("species-",name.str(),"-",vecSpecies[ispec]->name);
-        hid_t gid = H5::group(patch_gid, groupName);
-        
-        H5::attr(gid, "partCapacity", vecSpecies[ispec]->particles->capacity());
-        H5::attr(gid, "partSize", vecSpecies[ispec]->particles->size());
         
-        if (vecSpecies[ispec]->particles->size()>0) {
-            
-            for (unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++) {
-                ostringstream my_name("");
-                my_name << "Position-" << i;
-                H5::vect(gid,my_name.str(), vecSpecies[ispec]->particles->Position[i], dump_deflate);
-            }
-            
-            for (unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++) {
-                ostringstream my_name("");
-                my_name << "Momentum-" << i;
-                H5::vect(gid,my_name.str(), vecSpecies[ispec]->particles->Momentum[i], dump_deflate);
-            }
-            
-            H5::vect(gid,"Weight", vecSpecies[ispec]->particles->Weight, dump_deflate);
-            H5::vect(gid,"Charge", vecSpecies[ispec]->particles->Charge, dump_deflate);
-            
-            if (vecSpecies[ispec]->particles->tracked) {
-                H5::vect(gid,"Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64, dump_deflate);
+        // Species unchanged since the previous dump : link to its copy in the static file
+        if (differential) {
+            string target = staticName(patch_gid, groupName, checksum(vecSpecies[ispec]));
+            if (!target.empty()) {
+                if (static_objects.insert(target).second) {
+                    hid_t gid = H5::group(static_fid, target);
+                    dumpSpecies(vecSpecies[ispec], gid);
+                    H5Gclose(gid);
+                }
+                linkStatic(patch_gid, groupName, target);
+                continue;
             }
-            
-            
-            H5::vect(gid,"bmin", vecSpecies[ispec]->bmin);
-            H5::vect(gid,"bmax", vecSpecies[ispec]->bmax);
-            
-        } // End if partSize
+        }
         
+        hid_t gid = H5::group(patch_gid, groupName);
+        dumpSpecies(vecSpecies[ispec], gid);
         H5Gclose(gid);
         
     } // End for ispec
 };
 
 
+void Checkpoint::dumpSpecies( Species* species, hid_t gid )
+{
+    H5::attr(gid, "partCapacity", species->particles->capacity());
+    H5::attr(gid, "partSize", species->particles->size());
+    
+    if (species->particles->size()>0) {
+        
+        for (unsigned int i=0; i<species->particles->Position.size(); i++) {
+            ostringstream my_name("");
+            my_name << "Position-" << i;
+            H5::vect(gid,my_name.str(), species->particles->Position[i], dump_deflate);
+        }
+        
+        for (unsigned int i=0; i<species->particles->Momentum.size(); i++) {
+            ostringstream my_name("");
+            my_name << "Momentum-" << i;
+            H5::vect(gid,my_name.str(), species->particles->Momentum[i], dump_deflate);
+        }
+        
+        H5::vect(gid,"Weight", species->particles->Weight, dump_deflate);
+        H5::vect(gid,"Charge", species->particles->Charge, dump_deflate);
+        
+        if (species->particles->tracked) {
+            H5::vect(gid,"Id", species->particles->Id, H5T_NATIVE_UINT64, dump_deflate);
+        }
+        
+        
+        H5::vect(gid,"bmin", species->bmin);
+        H5::vect(gid,"bmax", species->bmax);
+        
+    } // End if partSize
+}
+
+
 void Checkpoint::readPatchDistribution( SmileiMPI* smpi, SimWindow* simWin )
 {
     hid_t fid = H5Fopen( restart_file.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
@@ -430,6 +477,11 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI* smpi, SimWindo
     hid_t fid = H5Fopen( restart_file.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
     if (fid < 0) ERROR(restart_file << " is not a valid HDF5 file");    
     
+    // Links to a static file (differential dumps) are relative to the directory of the restart file
+    size_t sep = restart_file.find_last_of(PATH_SEPARATOR);
+    restart_lapl = H5Pcreate( H5P_LINK_ACCESS );
+    H5Pset_elink_prefix( restart_lapl, sep==string::npos ? "." : restart_file.substr(0, sep).c_str() );
+    
     // Write diags scalar data
     DiagnosticScalar* scalars = static_cast<DiagnosticScalar*>(vecPatches.globalDiags[0]);
     H5::getAttr(fid, "Energy_time_zero",  scalars->Energy_time_zero );
@@ -494,6 +546,8 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI* smpi, SimWindo
         }
     }
     
+    H5Pclose( restart_lapl );
+    restart_lapl = H5P_DEFAULT;
     H5Fclose( fid );
     
 }
@@ -598,7 +652,7 @@ void Checkpoint::restartPatch( ElectroMagn* EMfields,std::vector<Species*> &vecS
         ostringstream name("");
         name << setfill('0') << setw(2) << ispec;
         string groupName=Tools::merge("species-",name.str(),"-",vecSpecies[ispec]->name);
-        hid_t gid = H5Gopen(patch_gid, groupName.c_str(),H5P_DEFAULT);
+        hid_t gid = H5Gopen(patch_gid, groupName.c_str(),restart_lapl);
         
         unsigned int partCapacity=0;
         H5::getAttr(gid, "partCapacity", partCapacity );
@@ -641,18 +695,229 @@ void Checkpoint::restartPatch( ElectroMagn* EMfields,std::vector<Species*> &vecS
 }
 
 void Checkpoint::dumpFieldsPerProc(hid_t fid, Field* field)
+{
+    // Field unchanged since the previous dump : link to its copy in the static file
+    if (differential) {
+        string target = staticName(fid, field->name, checksum(&field->data_[0], field->globalDims_*sizeof(double)));
+        if (!target.empty()) {
+            if (static_objects.insert(target).second)
+                writeFieldsPerProc(static_fid, target, field);
+            linkStatic(fid, field->name, target);
+            return;
+        }
+    }
+    
+    writeFieldsPerProc(fid, field->name, field);
+}
+
+void Checkpoint::writeFieldsPerProc(hid_t fid, string name, Field* field)
 {
     hsize_t dims[1]={field->globalDims_};
     hid_t sid = H5Screate_simple (1, dims, NULL);
-    hid_t did = H5Dcreate (fid, field->name.c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT,H5P_DEFAULT,H5P_DEFAULT);
+    hid_t did = H5Dcreate (fid, name.c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT,H5P_DEFAULT,H5P_DEFAULT);
     H5Dwrite(did, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &field->data_[0]);
     H5Dclose (did);
     H5Sclose(sid);
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Checksum of a memory block (xxHash64 rounds on 4 lanes), used to detect that dumped data has not changed.
+// Much faster than writing the data, and independent of the way the data was (or was not) modified.
+// ---------------------------------------------------------------------------------------------------------------------
+uint64_t Checkpoint::checksum(const void* data, size_t nbytes, uint64_t seed)
+{
+    const uint64_t prime1 = 11400714785074694791ULL;
+    const uint64_t prime2 = 14029467366897019727ULL;
+    const uint64_t prime3 =  1609587929392839161ULL;
+    const unsigned char* bytes = static_cast<const unsigned char*>( data );
+    
+    uint64_t lane[4] = { seed + prime1 + prime2, seed + prime2, seed, seed - prime1 };
+    size_t nwords = nbytes/8;
+    size_t iword = 0;
+    for ( ; iword+4<=nwords ; iword+=4 ) {
+        for ( int l=0 ; l<4 ; l++ ) {
+            uint64_t w;
+            memcpy( &w, bytes+8*(iword+l), 8 );
+            lane[l] += w*prime2;
+            lane[l]  = ( ( lane[l] << 31 ) | ( lane[l] >> 33 ) )*prime1;
+        }
+    }
+    uint64_t h = nbytes;
+    for ( int l=0 ; l<4 ; l++ )
+        h = ( ( h ^ lane[l] ) << 27 | ( h ^ lane[l] ) >> 37 )*prime1 + prime3;
+    for ( ; iword<nwords ; iword++ ) {
+        uint64_t w;
+        memcpy( &w, bytes+8*iword, 8 );
+        h ^= ( ( w*prime2 ) << 31 | ( w*prime2 ) >> 33 )*prime1;
+        h  = ( h << 27 | h >> 37 )*prime1 + prime3;
+    }
+    for ( size_t ibyte=8*nwords ; ibyte<nbytes ; ibyte++ ) {
+        h ^= bytes[ibyte]*prime3;
+        h  = ( h << 11 | h >> 53 )*prime1;
+    }
+    
+    // Final avalanche
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t Checkpoint::checksum(Species* species)
+{
+    Particles* particles = species->particles;
+    uint64_t h = checksum( NULL, 0, particles->size() );
+    h = checksum( NULL, 0, h ^ ( ( uint64_t )particles->capacity() << 32 ) );
+    for ( unsigned int i=0 ; i<particles->Position.size() ; i++ )
+        h = checksum( particles->Position[i].data(), particles->size()*sizeof(double), h );
+    for ( unsigned int i=0 ; i<particles->Momentum.size() ; i++ )
+        h = checksum( particles->Momentum[i].data(), particles->size()*sizeof(double), h );
+    h = checksum( particles->Weight.data(), particles->size()*sizeof(double), h );
+    h = checksum( particles->Charge.data(), particles->size()*sizeof(short), h );
+    if ( particles->tracked )
+        h = checksum( particles->Id.data(), particles->size()*sizeof(uint64_t), h );
+    h = checksum( species->bmin.data(), species->bmin.size()*sizeof(int), h );
+    h = checksum( species->bmax.data(), species->bmax.size()*sizeof(int), h );
+    return h;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Objects are identified by their path in the dump file (e.g. /patch-000012/species-00-ion). An object with the same
+// checksum at two consecutive dumps is considered static : it is copied once in the static file, under its flattened
+// path and checksum, and the next dumps only hold an external link to this copy (followed transparently at restart).
+// Data which changes at every dump is always written in the dump file itself.
+// ---------------------------------------------------------------------------------------------------------------------
+string Checkpoint::staticName(hid_t loc_id, string name, uint64_t hash)
+{
+    char loc_name[1024];
+    H5Iget_name( loc_id, loc_name, sizeof(loc_name) );
+    string path = string( loc_name ) + "/" + name;
+    
+    map<string, uint64_t>::iterator last = last_checksum.find( path );
+    bool unchanged = ( last != last_checksum.end() && last->second == hash );
+    next_checksum[path] = hash;
+    if (!unchanged)
+        return "";
+    
+    string target = path.substr( 1 );
+    replace( target.begin(), target.end(), '/', '.' );
+    ostringstream hex_hash("");
+    hex_hash << hex << setfill('0') << setw(16) << hash;
+    return target + "." + hex_hash.str();
+}
+
+// Collects the objects of the static file linked by a dump file (callback of H5Lvisit)
+static herr_t collectStaticLinks(hid_t gid, const char* name, const H5L_info_t* info, void* data)
+{
+    if (info->type != H5L_TYPE_EXTERNAL)
+        return 0;
+    pair<string, set<string>*>* links = static_cast<pair<string, set<string>*>*>( data );
+    vector<char> value( info->u.val_size );
+    const char *file, *object;
+    if( H5Lget_val( gid, name, &value[0], value.size(), H5P_DEFAULT ) >= 0
+     && H5Lunpack_elink_val( &value[0], value.size(), NULL, &file, &object ) >= 0
+     && links->first == file )
+        links->second->insert( object );
+    return 0;
+}
+
+// Lists the top-level objects of the static file (callback of H5Literate)
+static herr_t collectStaticObjects(hid_t gid, const char* name, const H5L_info_t* info, void* data)
+{
+    static_cast<set<string>*>( data )->insert( name );
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Opens the static file in dumpDir for the dump being written in the slot num_dump. On the first dump of the run, the
+// content of the static file and the links of the dumps already present (previous run in the same directory) are read
+// back, so that they are pruned like the ones of this run.
+// ---------------------------------------------------------------------------------------------------------------------
+void Checkpoint::openStaticFile(string dumpDir, string dumpFile, unsigned int num_dump)
+{
+    string staticPath = dumpDir + static_file;
+    
+    if (dump_links.empty()) {
+        dump_links.resize( keep_n_dumps );
+        for (unsigned int idump=0; idump<keep_n_dumps; idump++) {
+            if (idump == num_dump) continue;
+            ostringstream name("");
+            name << dumpDir << "dump-" << setfill('0') << setw(5) << idump << dumpFile.substr(10);
+            if (! ifstream(name.str().c_str()).good()) continue;
+            hid_t fid = H5Fopen( name.str().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            if (fid < 0) continue;
+            pair<string, set<string>*> links( static_file, &dump_links[idump] );
+            H5Lvisit( fid, H5_INDEX_NAME, H5_ITER_NATIVE, collectStaticLinks, &links );
+            H5Fclose( fid );
+        }
+        if (ifstream(staticPath.c_str()).good()) {
+            static_fid = H5Fopen( staticPath.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+            H5Literate( static_fid, H5_INDEX_NAME, H5_ITER_NATIVE, NULL, collectStaticObjects, &static_objects );
+            return;
+        }
+    }
+    
+    // The dump previously in this slot has just been overwritten
+    dump_links[num_dump].clear();
+    
+    if (static_objects.empty())
+        static_fid = H5Fcreate( staticPath.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    else
+        static_fid = H5Fopen( staticPath.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+}
+
+// Links name in loc_id to the object target of the static file, and records it as used by the current dump
+void Checkpoint::linkStatic(hid_t loc_id, string name, string target)
+{
+    H5Lcreate_external(static_file.c_str(), target.c_str(), loc_id, name.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+    dump_links[(dump_number-1) % keep_n_dumps].insert( target );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Deletes the objects of the static file that no kept dump links any more (their last dump was overwritten), then
+// closes it. Deleted objects leave unused space in the file : it is rewritten with the remaining objects once they
+// are outnumbered by the deleted ones, and removed when nothing remains.
+// ---------------------------------------------------------------------------------------------------------------------
+void Checkpoint::pruneStaticFile(string staticPath)
+{
+    set<string> linked;
+    for (unsigned int idump=0; idump<dump_links.size(); idump++)
+        linked.insert( dump_links[idump].begin(), dump_links[idump].end() );
+    
+    for (set<string>::iterator it=static_objects.begin(); it!=static_objects.end(); ) {
+        if (linked.count( *it )) {
+            it++;
+        } else {
+            H5Ldelete( static_fid, it->c_str(), H5P_DEFAULT );
+            static_objects.erase( it++ );
+            static_unlinked++;
+        }
+    }
+    
+    if (static_objects.empty()) {
+        H5Fclose( static_fid );
+        remove( staticPath.c_str() );
+        static_unlinked = 0;
+    } else if (static_unlinked >= static_objects.size()) {
+        string tmpPath = staticPath + ".tmp";
+        hid_t tmp_fid = H5Fcreate( tmpPath.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        for (set<string>::iterator it=static_objects.begin(); it!=static_objects.end(); it++)
+            H5Ocopy( static_fid, it->c_str(), tmp_fid, it->c_str(), H5P_DEFAULT, H5P_DEFAULT );
+        H5Fclose( tmp_fid );
+        H5Fclose( static_fid );
+        rename( tmpPath.c_str(), staticPath.c_str() );
+        static_unlinked = 0;
+    } else {
+        H5Fclose( static_fid );
+    }
+    static_fid = -1;
+}
+
 void Checkpoint::restartFieldsPerProc(hid_t fid, Field* field)
 {
-    hid_t did = H5Dopen (fid, field->name.c_str(),H5P_DEFAULT);
+    hid_t did = H5Dopen (fid, field->name.c_str(),restart_lapl);
     H5Dread(did, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &field->data_[0]);
     H5Dclose (did);
 }
@@ -9,6 +9,9 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <set>
+#include <cstdint>
 
 #include <hdf5.h>
 #include <Tools.h>
@@ -98,6 +101,27 @@ private:
     
     //! dump field per proc
     void dumpFieldsPerProc(hid_t fid, Field* field);
+    //! write the data of field in the dataset name of fid
+    void writeFieldsPerProc(hid_t fid, std::string name, Field* field);
+    
+    //! dump the particles of a species in the group gid
+    void dumpSpecies(Species* species, hid_t gid);
+    
+    //! checksum of nbytes at data, chained from seed : modification marker of the dumped data
+    static uint64_t checksum(const void* data, size_t nbytes, uint64_t seed=0);
+    //! checksum of all the species data written by dumpSpecies
+    static uint64_t checksum(Species* species);
+    
+    //! If the object name of loc_id has the same checksum as at the previous dump, returns the name of its copy in
+    //! the static file (to be written if not yet in static_objects), else an empty string
+    std::string staticName(hid_t loc_id, std::string name, uint64_t hash);
+    
+    //! open the static file of the directory dumpDir for the dump file dumpFile of the slot num_dump
+    void openStaticFile(std::string dumpDir, std::string dumpFile, unsigned int num_dump);
+    //! link name in loc_id to the object target of the static file
+    void linkStatic(hid_t loc_id, std::string name, std::string target);
+    //! remove from the static file the objects not linked by any kept dump, and close it
+    void pruneStaticFile(std::string staticPath);
     
     //! dump moving window parameters
     void dumpMovingWindow(hid_t fid, SimWindow* simWindow);
@@ -132,6 +156,30 @@ private:
     //! group checkpoint files in subdirs of file_grouping files
     unsigned int file_grouping;
     
+    //! data unchanged between two dumps is written once in a static file and only linked by the next dumps
+    bool differential;
+    
+    //! static file of this process (name relative to the directory of the dump files, and opened file during a dump)
+    std::string static_file;
+    hid_t static_fid;
+    
+    //! checksum of each dumped object at the previous dump, by path in the dump file
+    std::map<std::string, uint64_t> last_checksum;
+    //! checksum of each object of the dump being written (becomes last_checksum once the dump is complete)
+    std::map<std::string, uint64_t> next_checksum;
+    
+    //! objects present in the static file
+    std::set<std::string> static_objects;
+    
+    //! objects of the static file linked by each of the keep_n_dumps dump files
+    std::vector< std::set<std::string> > dump_links;
+    
+    //! number of objects deleted from the static file since it was last rewritten
+    unsigned int static_unlinked;
+    
+    //! link access properties of the restart (external links are relative to the directory of the restart file)
+    hid_t restart_lapl;
+    
     //! restart file
     std::string restart_file;
 
@@ -157,6 +157,7 @@ void DiagnosticScalar::init(Params& params, SmileiMPI* smpi, VectorPatch& vecPat
                                                       || allowedKey(Tools::merge("Zavg_",species_name))
                                                       || allowedKey(Tools::merge("Ukin_",species_name))
                                                       || allowedKey(Tools::merge("Urad_",species_name))
+                                                      || allowedKey(Tools::merge("Nmrg_",species_name))
                                                       || allowedKey("UmBWpairs");
         }
     }
@@ -196,7 +197,7 @@ void DiagnosticScalar::init(Params& params, SmileiMPI* smpi, VectorPatch& vecPat
     // 2 - Prepare the Scalar* objects that will contain the data
     // ----------------------------------------------------------
 
-    values_SUM   .reserve( 13 + nspec*5 + 6 + 2*npoy);
+    values_SUM   .reserve( 13 + nspec*6 + 6 + 2*npoy);
     values_MINLOC.reserve( 10 );
     values_MAXLOC.reserve( 10 );
 
@@ -222,6 +223,7 @@ void DiagnosticScalar::init(Params& params, SmileiMPI* smpi, VectorPatch& vecPat
     sZavg.resize(nspec, NULL);
     sUkin.resize(nspec, NULL);
     sUrad.resize(nspec, NULL);
+    sNmrg.resize(nspec, NULL);
     for( unsigned int ispec=0; ispec<nspec; ispec++ ) {
         if (! vecPatches(0)->vecSpecies[ispec]->particles->is_test) {
             species_name = vecPatches(0)->vecSpecies[ispec]->name;
@@ -230,6 +232,8 @@ void DiagnosticScalar::init(Params& params, SmileiMPI* smpi, VectorPatch& vecPat
             sZavg[ispec] = newScalar_SUM( Tools::merge("Zavg_", species_name) );
             sUkin[ispec] = newScalar_SUM( Tools::merge("Ukin_", species_name) );
             sUrad[ispec] = newScalar_SUM( Tools::merge("Urad_", species_name) );
+            if (vecPatches(0)->vecSpecies[ispec]->Merge)
+                sNmrg[ispec] = newScalar_SUM( Tools::merge("Nmrg_", species_name) );
         }
     }
 
@@ -410,6 +414,12 @@ void DiagnosticScalar::compute( Patch* patch, int timestep )
                                  vecSpecies[ispec]->getNrjRadiation();
             }
 
+            // If merging activated, number of macro-particles removed
+            if (vecSpecies[ispec]->Merge)
+            {
+                *sNmrg[ispec] += (double)vecSpecies[ispec]->getNbrOfMergedParticles();
+            }
+
             // incremement the total kinetic energy
             Ukin_ += cell_volume * ener_tot;
             // increment the total radiated energy
@@ -679,6 +689,8 @@ uint64_t DiagnosticScalar::getDiskFootPrint(int istart, int istop, Patch* patch)
             scalars.push_back( Tools::merge("Zavg_", species_name) );
             scalars.push_back( Tools::merge("Ukin_", species_name) );
             scalars.push_back( Tools::merge("Urad_", species_name) );
+            if (patch->vecSpecies[ispec]->Merge)
+                scalars.push_back( Tools::merge("Nmrg_", species_name) );
         }
     }
     // 3 - Field scalars
@@ -53,6 +53,7 @@ nrj_new_fields (  0.               )
     
     MaxwellAmpereSolver_  = SolverFactory::createMA(params);
     MaxwellFaradaySolver_ = SolverFactory::createMF(params);
+    MaxwellFusedSolver_   = SolverFactory::createFused(params);
     
 }
 
@@ -80,6 +81,38 @@ nrj_new_fields ( 0. )
     
     MaxwellAmpereSolver_  = SolverFactory::createMA(params);
     MaxwellFaradaySolver_ = SolverFactory::createMF(params);
+    MaxwellFusedSolver_   = SolverFactory::createFused(params);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Allocate the FieldArena of the fields created by the constructors of the derived classes
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::allocateArena( Params& params )
+{
+    if (!params.field_arena)
+        return;
+    
+    vector<unsigned int> dims( nDim_field );
+    size_t size = 0;
+    
+    for (unsigned int icomp=0 ; icomp<3 ; icomp++) {
+        // Component icomp of E and J : dual along icomp
+        for (unsigned int i=0 ; i<nDim_field ; i++)
+            dims[i] = n_space[i]+1+2*oversize[i] + (i==icomp ? 1 : 0);
+        size += 2*Field::arenaSize( dims );
+        // Component icomp of B and B_m : dual along the other directions
+        for (unsigned int i=0 ; i<nDim_field ; i++)
+            dims[i] = n_space[i]+1+2*oversize[i] + (i==icomp ? 0 : 1);
+        size += 2*Field::arenaSize( dims );
+    }
+    
+    // rho : primal
+    for (unsigned int i=0 ; i<nDim_field ; i++)
+        dims[i] = n_space[i]+1+2*oversize[i];
+    size += Field::arenaSize( dims );
+    
+    arena_.allocate( size, params.field_arena_huge_pages, params.shared_memory_exchanges );
+    FieldArena::current = &arena_;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -210,6 +243,7 @@ ElectroMagn::~ElectroMagn()
     
     delete MaxwellAmpereSolver_;
     delete MaxwellFaradaySolver_;
+    delete MaxwellFusedSolver_;
     
     //antenna cleanup
     for (vector<Antenna>::iterator antenna=antennas.begin(); antenna!=antennas.end(); antenna++ ) {
@@ -348,6 +382,39 @@ void ElectroMagn::restartRhoJs()
     rho_->put_to(0.);
 }
 
+void ElectroMagn::allocateRhoJs()
+{
+    for (unsigned int ispec=0 ; ispec < n_species ; ispec++) {
+        if( Jx_s [ispec] && !Jx_s [ispec]->data_ ) Jx_s [ispec]->allocateDims(0, false);
+        if( Jy_s [ispec] && !Jy_s [ispec]->data_ ) Jy_s [ispec]->allocateDims(1, false);
+        if( Jz_s [ispec] && !Jz_s [ispec]->data_ ) Jz_s [ispec]->allocateDims(2, false);
+        if( rho_s[ispec] && !rho_s[ispec]->data_ ) rho_s[ispec]->allocateDims();
+    }
+}
+
+void ElectroMagn::releaseRhoJs()
+{
+    vector<Field*>* fields[4] = { &Jx_s, &Jy_s, &Jz_s, &rho_s };
+    for (unsigned int i=0 ; i<4 ; i++) {
+        for (unsigned int ispec=0 ; ispec < n_species ; ispec++) {
+            Field* field = (*fields[i])[ispec];
+            if( field && field->data_ ) {
+                field->deallocateDims();
+                // Back to the dimensions of a field created without allocating, as in the constructors
+                field->dims_ = dimPrim;
+            }
+        }
+    }
+}
+
+double* ElectroMagn::filterTarget( Field* field, unsigned int passes )
+{
+    // Reuses the capacity of the previous components and timesteps
+    filterBuffer_.assign( field->data_, field->data_ + field->globalDims_ );
+    // The points which are not filtered are identical in both arrays
+    return passes%2 ? field->data_ : &filterBuffer_[0];
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Increment an averaged field
 // ---------------------------------------------------------------------------------------------------------------------
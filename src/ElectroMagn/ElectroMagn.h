@@ -207,6 +207,10 @@ public:
     void restartRhoJ();
     //! Method used to initialize the total charge currents and densities of species
     void restartRhoJs();
+    //! Allocate the currents and densities of species requested by the diags (non-NULL), released or not yet allocated
+    void allocateRhoJs();
+    //! Release the memory of the currents and densities of species, until the next timestep which needs them
+    void releaseRhoJs();
     
     //! Method used to sum all species densities and currents to compute the total charge density and currents
     virtual void computeTotalRhoJ() = 0;
@@ -258,9 +262,14 @@ public:
     Solver* MaxwellAmpereSolver_;
     //! Maxwell Faraday Solver
     Solver* MaxwellFaradaySolver_;
+    //! saveMagneticFields, Maxwell Ampere and Maxwell Faraday in a single sweep (NULL if not Main.fused_field_step)
+    Solver* MaxwellFusedSolver_;
     virtual void saveMagneticFields(bool) = 0;
     virtual void centerMagneticFields() = 0;
     virtual void binomialCurrentFilter() = 0;
+    //! Apply passes of the binomial filter on currents without exchange in between (CurrentFilter.single_exchange):
+    //! the ghost cells are valid up to the oversize minus the number of passes, and are exchanged once afterwards
+    virtual void multipassBinomialCurrentFilter(unsigned int passes) = 0;
     
     void boundaryConditions(int itime, double time_dual, Patch* patch, Params &params, SimWindow* simWindow);
     
@@ -376,9 +385,25 @@ public:
     std::vector<double> beta_edge;
     std::vector<std::vector<double>> S_edge;
 
+    //! Memory of the fields created by the constructors (Main.field_arena)
+    inline const FieldArena& arena() const {
+        return arena_;
+    }
+
 protected :
     bool is_pxr;
     
+    //! Memory of the fields created by the constructors (Main.field_arena)
+    FieldArena arena_;
+    //! Map arena_ for E, B, B_m, J and rho, and make it the arena of the calling thread, until these fields are created
+    void allocateArena( Params& params );
+    
+    //! Copy of a current component, swapped with it between the passes of multipassBinomialCurrentFilter
+    std::vector<double> filterBuffer_;
+    //! Make filterBuffer_ a copy of field, and return the array to which the first of the passes must write,
+    //! so that the last one writes to field
+    double* filterTarget( Field* field, unsigned int passes );
+    
     
 private:
     
@@ -25,7 +25,10 @@ using namespace std;
 ElectroMagn1D::ElectroMagn1D(Params &params, DomainDecomposition* domain_decomposition, vector<Species*>& vecSpecies, Patch* patch)
   : ElectroMagn(params, domain_decomposition, vecSpecies, patch)
 {
+    allocateArena(params);
     initElectroMagn1DQuantities(params, patch);
+    // The fields of the species stay out of the arena, so that releaseRhoJs frees them
+    FieldArena::current = NULL;
     
     // Charge and current densities for each species
     for (unsigned int ispec=0; ispec<n_species; ispec++) {
@@ -34,14 +37,16 @@ ElectroMagn1D::ElectroMagn1D(Params &params, DomainDecomposition* domain_decompo
         Jz_s[ispec]  = new Field1D(Tools::merge("Jz_" ,vecSpecies[ispec]->name).c_str(), dimPrim);
         rho_s[ispec] = new Field1D(Tools::merge("Rho_",vecSpecies[ispec]->name).c_str(), dimPrim);
     }
-    
 }//END constructor Electromagn1D
 
 
 ElectroMagn1D::ElectroMagn1D( ElectroMagn1D* emFields, Params &params, Patch* patch )
     : ElectroMagn(emFields, params, patch)
 {
+    allocateArena(params);
     initElectroMagn1DQuantities(params, patch);
+    // The fields of the species stay out of the arena, so that releaseRhoJs frees them
+    FieldArena::current = NULL;
     
     // Charge and current densities for each species
     for (unsigned int ispec=0; ispec<n_species; ispec++) {
@@ -577,6 +582,29 @@ void ElectroMagn1D::binomialCurrentFilter()
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Apply several passes of the binomial filter on currents, without exchange in between
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn1D::multipassBinomialCurrentFilter(unsigned int passes)
+{
+    Field* J[3] = { Jx_, Jy_, Jz_ };
+    
+    // 3-point filter: (2*point itself + 1*(2*neighbors))/4, the 2 border points are not filtered
+    for (unsigned int icomp=0 ; icomp<3 ; icomp++) {
+        unsigned int nx = J[icomp]->dims_[0];
+        double* out = filterTarget( J[icomp], passes );
+        double* in  = out==J[icomp]->data_ ? &filterBuffer_[0] : J[icomp]->data_;
+        for (unsigned int ipass=0 ; ipass<passes ; ipass++) {
+            #pragma omp simd
+            for (unsigned int ix=1 ; ix<nx-1 ; ix++) {
+                out[ix] = (in[ix-1] + 2.*in[ix] + in[ix+1])*0.25;
+            }
+            swap( in, out );
+        }
+    }
+    
+}//END multipassBinomialCurrentFilter
+
 
 
 // Create a new field
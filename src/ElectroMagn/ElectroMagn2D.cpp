@@ -26,7 +26,10 @@ isYmin(patch->isYmin()),
 isYmax(patch->isYmax())
 {    
     
+    allocateArena(params);
     initElectroMagn2DQuantities(params, patch);
+    // The fields of the species stay out of the arena, so that releaseRhoJs frees them
+    FieldArena::current = NULL;
     
     // Charge currents currents and density for each species
     for (unsigned int ispec=0; ispec<n_species; ispec++) {
@@ -35,9 +38,6 @@ isYmax(patch->isYmax())
         Jz_s[ispec]  = new Field2D(Tools::merge("Jz_" ,vecSpecies[ispec]->name).c_str(), dimPrim);
         rho_s[ispec] = new Field2D(Tools::merge("Rho_",vecSpecies[ispec]->name).c_str(), dimPrim);
     }
-    
-
-    
 }//END constructor Electromagn2D
 
 
@@ -47,7 +47,10 @@ isYmin(patch->isYmin()),
 isYmax(patch->isYmax())
 {
     
+    allocateArena(params);
     initElectroMagn2DQuantities(params, patch);
+    // The fields of the species stay out of the arena, so that releaseRhoJs frees them
+    FieldArena::current = NULL;
     
     // Charge currents currents and density for each species
     for (unsigned int ispec=0; ispec<n_species; ispec++) {
@@ -76,7 +79,6 @@ isYmax(patch->isYmax())
                 rho_s[ispec]  = new Field2D(emFields->rho_s[ispec]->name, dimPrim);
         }
     }
-    
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -947,6 +949,37 @@ void ElectroMagn2D::binomialCurrentFilter()
 }//END binomialCurrentFilter
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Apply several passes of the binomial filter on currents, without exchange in between
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn2D::multipassBinomialCurrentFilter(unsigned int passes)
+{
+    Field* J[3] = { Jx_, Jy_, Jz_ };
+    
+    // Same 9-point filter as binomialCurrentFilter, from one array to the other, the border points are not filtered
+    for (unsigned int icomp=0 ; icomp<3 ; icomp++) {
+        unsigned int nx = J[icomp]->dims_[0];
+        unsigned int ny = J[icomp]->dims_[1];
+        double* out = filterTarget( J[icomp], passes );
+        double* in  = out==J[icomp]->data_ ? &filterBuffer_[0] : J[icomp]->data_;
+        for (unsigned int ipass=0 ; ipass<passes ; ipass++) {
+            for (unsigned int i=1; i<nx-1; i++) {
+                const double* m = in + (i-1)*ny;
+                const double* c = in +  i   *ny;
+                const double* p = in + (i+1)*ny;
+                double* o = out + i*ny;
+                #pragma omp simd
+                for (unsigned int j=1; j<ny-1; j++) {
+                    o[j] = (p[j-1] + 2.*p[j] + p[j+1] + 2.*c[j-1] + 4.*c[j] + 2.*c[j+1] + m[j-1] + 2.*m[j] + m[j+1])/16.;
+                }
+            }
+            swap( in, out );
+        }
+    }
+    
+}//END multipassBinomialCurrentFilter
+
+
 //// ---------------------------------------------------------------------------------------------------------------------
 //// Solve the Maxwell-Ampere equation
 //// ---------------------------------------------------------------------------------------------------------------------
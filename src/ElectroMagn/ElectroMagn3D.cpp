@@ -28,7 +28,10 @@ isZmax(patch->isZmax()),
 isZmin(patch->isZmin())
 {    
     
+    allocateArena(params);
     initElectroMagn3DQuantities(params, patch);
+    // The fields of the species stay out of the arena, so that releaseRhoJs frees them
+    FieldArena::current = NULL;
     
     // Charge currents currents and density for each species
     for (unsigned int ispec=0; ispec<n_species; ispec++) {
@@ -37,7 +40,6 @@ isZmin(patch->isZmin())
         Jz_s[ispec]  = new Field3D(Tools::merge("Jz_" ,vecSpecies[ispec]->name).c_str(), dimPrim);
         rho_s[ispec] = new Field3D(Tools::merge("Rho_",vecSpecies[ispec]->name).c_str(), dimPrim);
     }
-    
 }//END constructor Electromagn3D
 
 
@@ -49,7 +51,10 @@ isZmax(patch->isZmax()),
 isZmin(patch->isZmin())
 {
     
+    allocateArena(params);
     initElectroMagn3DQuantities(params, patch);
+    // The fields of the species stay out of the arena, so that releaseRhoJs frees them
+    FieldArena::current = NULL;
     
     // Charge currents currents and density for each species
     for (unsigned int ispec=0; ispec<n_species; ispec++) {
@@ -78,8 +83,6 @@ isZmin(patch->isZmin())
                 rho_s[ispec]  = new Field3D(emFields->rho_s[ispec]->name, dimPrim);
         }
     }
-
-
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1278,6 +1281,49 @@ void ElectroMagn3D::binomialCurrentFilter()
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Apply several passes of the binomial filter on currents, without exchange in between
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn3D::multipassBinomialCurrentFilter(unsigned int passes)
+{
+    Field* J[3] = { Jx_, Jy_, Jz_ };
+    
+    // 27-point filter (1-2-1 in each direction)/64, from one array to the other, the border points are not filtered
+    for (unsigned int icomp=0 ; icomp<3 ; icomp++) {
+        unsigned int nx = J[icomp]->dims_[0];
+        unsigned int ny = J[icomp]->dims_[1];
+        unsigned int nz = J[icomp]->dims_[2];
+        double* out = filterTarget( J[icomp], passes );
+        double* in  = out==J[icomp]->data_ ? &filterBuffer_[0] : J[icomp]->data_;
+        for (unsigned int ipass=0 ; ipass<passes ; ipass++) {
+            for (unsigned int i=1; i<nx-1; i++) {
+                for (unsigned int j=1; j<ny-1; j++) {
+                    // Rows (i-1:i+1, j-1:j+1)
+                    const double* mm = in + ((i-1)*ny+j-1)*nz;
+                    const double* mc = mm + nz;
+                    const double* mp = mc + nz;
+                    const double* cm = in + ( i   *ny+j-1)*nz;
+                    const double* cc = cm + nz;
+                    const double* cp = cc + nz;
+                    const double* pm = in + ((i+1)*ny+j-1)*nz;
+                    const double* pc = pm + nz;
+                    const double* pp = pc + nz;
+                    double* o = out + (i*ny+j)*nz;
+                    #pragma omp simd
+                    for (unsigned int k=1; k<nz-1; k++) {
+                        double s_m = mm[k-1] + 2.*mc[k-1] + mp[k-1] + 2.*(cm[k-1] + 2.*cc[k-1] + cp[k-1]) + pm[k-1] + 2.*pc[k-1] + pp[k-1];
+                        double s_c = mm[k  ] + 2.*mc[k  ] + mp[k  ] + 2.*(cm[k  ] + 2.*cc[k  ] + cp[k  ]) + pm[k  ] + 2.*pc[k  ] + pp[k  ];
+                        double s_p = mm[k+1] + 2.*mc[k+1] + mp[k+1] + 2.*(cm[k+1] + 2.*cc[k+1] + cp[k+1]) + pm[k+1] + 2.*pc[k+1] + pp[k+1];
+                        o[k] = (s_m + 2.*s_c + s_p)/64.;
+                    }
+                }
+            }
+            swap( in, out );
+        }
+    }
+    
+}//END multipassBinomialCurrentFilter
+
 void ElectroMagn3D::center_fields_from_relativistic_Poisson(Patch *patch){
 
       
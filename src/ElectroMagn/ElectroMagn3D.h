@@ -63,6 +63,9 @@ public:
     //! Method used to apply a single-pass binomial filter on currents
     void binomialCurrentFilter();
     
+    //! Method used to apply several passes of the binomial filter on currents, without exchange in between
+    void multipassBinomialCurrentFilter(unsigned int passes);
+    
     //! Creates a new field with the right characteristics, depending on the name
     Field * createField(std::string fieldname);
     
@@ -0,0 +1,48 @@
+
+#include "MAMF_Solver3D_Yee.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+
+MAMF_Solver3D_Yee::MAMF_Solver3D_Yee(Params &params)
+: Solver3D(params),
+  ampere_(params),
+  faraday_(params)
+{
+}
+
+MAMF_Solver3D_Yee::~MAMF_Solver3D_Yee()
+{
+}
+
+void MAMF_Solver3D_Yee::operator() ( ElectroMagn* fields )
+{
+    const double* Bx = fields->Bx_->data_;
+    const double* By = fields->By_->data_;
+    const double* Bz = fields->Bz_->data_;
+    double* Bx_m = fields->Bx_m->data_;
+    double* By_m = fields->By_m->data_;
+    double* Bz_m = fields->Bz_m->data_;
+
+    for (unsigned int j0=0 ; j0<ny_d ; j0+=tile_y) {
+        unsigned int j1 = std::min( j0+tile_y, ny_d );
+        unsigned int j1_p = std::min( j1, ny_p );
+        for (unsigned int i=0 ; i<nx_d ; i++) {
+
+            // Stores B at time n in B_m, before the block is advanced
+            if ( i<nx_p )
+                memcpy( Bx_m + (i*ny_d + j0)*nz_d, Bx + (i*ny_d + j0)*nz_d, (j1-j0)*nz_d*sizeof(double) );
+            if ( j0<j1_p )
+                memcpy( By_m + (i*ny_p + j0)*nz_d, By + (i*ny_p + j0)*nz_d, (j1_p-j0)*nz_d*sizeof(double) );
+            memcpy( Bz_m + (i*ny_d + j0)*nz_p, Bz + (i*ny_d + j0)*nz_p, (j1-j0)*nz_p*sizeof(double) );
+
+            ampere_.plane( fields, i, j0, j1 );
+            faraday_.plane( fields, i, j0, j1 );
+        }
+    }
+
+}
+
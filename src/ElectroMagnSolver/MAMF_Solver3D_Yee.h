@@ -0,0 +1,32 @@
+#ifndef MAMF_SOLVER3D_YEE_H
+#define MAMF_SOLVER3D_YEE_H
+
+#include "Solver3D.h"
+#include "MA_Solver3D_norm.h"
+#include "MF_Solver3D_Yee.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MAMF_Solver3D_Yee : saving of B in B_m, Maxwell-Ampere and Maxwell-Faraday (Yee) in a single sweep
+//! of the patch (Main.fused_field_step). In each cache block, the x-plane i of E is advanced, then the x-plane i
+//! of B, which needs the new E in the planes i and i-1, while E in the plane i+1 still needs the old B.
+//  --------------------------------------------------------------------------------------------------------------------
+class MAMF_Solver3D_Yee : public Solver3D
+{
+
+public:
+    //! Creator for MAMF_Solver3D_Yee
+    MAMF_Solver3D_Yee(Params &params);
+    virtual ~MAMF_Solver3D_Yee();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn* fields);
+
+protected:
+    MA_Solver3D_norm ampere_;
+    MF_Solver3D_Yee  faraday_;
+
+};//END class
+
+#endif
+
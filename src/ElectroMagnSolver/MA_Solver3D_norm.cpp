@@ -1,6 +1,8 @@
 
 #include "MA_Solver3D_norm.h"
 
+#include <algorithm>
+
 #include "ElectroMagn.h"
 #include "Field3D.h"
 
@@ -13,50 +15,83 @@ MA_Solver3D_norm::~MA_Solver3D_norm()
 {
 }
 
+// Cache blocks : one x-plane of tile_y rows, in which Ex, Ey and Ez are updated one after the other.
+// The x-plane i+1 of B, read for the plane i, is still in cache when the plane i+1 is computed.
 void MA_Solver3D_norm::operator() ( ElectroMagn* fields )
 {
+    for (unsigned int j0=0 ; j0<ny_d ; j0+=tile_y) {
+        unsigned int j1 = std::min( j0+tile_y, ny_d );
+        for (unsigned int i=0 ; i<nx_d ; i++)
+            plane( fields, i, j0, j1 );
+    }
+}
 
-    // Static-cast of the fields
-    Field3D* Ex3D = static_cast<Field3D*>(fields->Ex_);
-    Field3D* Ey3D = static_cast<Field3D*>(fields->Ey_);
-    Field3D* Ez3D = static_cast<Field3D*>(fields->Ez_);
-    Field3D* Bx3D = static_cast<Field3D*>(fields->Bx_);
-    Field3D* By3D = static_cast<Field3D*>(fields->By_);
-    Field3D* Bz3D = static_cast<Field3D*>(fields->Bz_);
-    Field3D* Jx3D = static_cast<Field3D*>(fields->Jx_);
-    Field3D* Jy3D = static_cast<Field3D*>(fields->Jy_);
-    Field3D* Jz3D = static_cast<Field3D*>(fields->Jz_);
+
+// The z direction, contiguous in memory, is the vectorized inner loop
+void MA_Solver3D_norm::plane( ElectroMagn* fields, unsigned int i, unsigned int j0, unsigned int j1 )
+{
+    double* Ex = fields->Ex_->data_;
+    double* Ey = fields->Ey_->data_;
+    double* Ez = fields->Ez_->data_;
+    const double* Bx = fields->Bx_->data_;
+    const double* By = fields->By_->data_;
+    const double* Bz = fields->Bz_->data_;
+    const double* Jx = fields->Jx_->data_;
+    const double* Jy = fields->Jy_->data_;
+    const double* Jz = fields->Jz_->data_;
+
+    // Local copies : the compiler can not assume that the fields do not alias the members
+    const unsigned int nx_p = this->nx_p;
+    const unsigned int ny_p = this->ny_p, ny_d = this->ny_d;
+    const unsigned int nz_p = this->nz_p, nz_d = this->nz_d;
+    const double dt = this->dt, dt_ov_dx = this->dt_ov_dx, dt_ov_dy = this->dt_ov_dy, dt_ov_dz = this->dt_ov_dz;
 
     // Electric field Ex^(d,p,p)
-    for (unsigned int i=0 ; i<nx_d ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            for (unsigned int k=0 ; k<nz_p ; k++) {
-                (*Ex3D)(i,j,k) += -dt*(*Jx3D)(i,j,k)
-                +                 dt_ov_dy * ( (*Bz3D)(i,j+1,k) - (*Bz3D)(i,j,k) )
-                -                 dt_ov_dz * ( (*By3D)(i,j,k+1) - (*By3D)(i,j,k) );
-            }
+    for (unsigned int j=j0 ; j<std::min(j1,ny_p) ; j++) {
+        double*       ex  = Ex + (i*ny_p + j)*nz_p;
+        const double* jx  = Jx + (i*ny_p + j)*nz_p;
+        const double* by  = By + (i*ny_p + j)*nz_d;
+        const double* bz  = Bz + (i*ny_d + j)*nz_p;
+        const double* bzp = bz + nz_p;
+        #pragma omp simd
+        for (unsigned int k=0 ; k<nz_p ; k++) {
+            ex[k] += -dt*jx[k]
+            +        dt_ov_dy * ( bzp[k] - bz[k] )
+            -        dt_ov_dz * ( by[k+1] - by[k] );
         }
     }
-    
+
+    if ( i>=nx_p )
+        return;
+
     // Electric field Ey^(p,d,p)
-    for (unsigned int i=0 ; i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_d ; j++) {
-            for (unsigned int k=0 ; k<nz_p ; k++) {
-                (*Ey3D)(i,j,k) += -dt*(*Jy3D)(i,j,k)
-                -                  dt_ov_dx * ( (*Bz3D)(i+1,j,k) - (*Bz3D)(i,j,k) )
-                +                  dt_ov_dz * ( (*Bx3D)(i,j,k+1) - (*Bx3D)(i,j,k) );
-            }
+    for (unsigned int j=j0 ; j<j1 ; j++) {
+        double*       ey  = Ey + (i*ny_d + j)*nz_p;
+        const double* jy  = Jy + (i*ny_d + j)*nz_p;
+        const double* bx  = Bx + (i*ny_d + j)*nz_d;
+        const double* bz  = Bz + (i*ny_d + j)*nz_p;
+        const double* bzp = bz + ny_d*nz_p;
+        #pragma omp simd
+        for (unsigned int k=0 ; k<nz_p ; k++) {
+            ey[k] += -dt*jy[k]
+            -        dt_ov_dx * ( bzp[k] - bz[k] )
+            +        dt_ov_dz * ( bx[k+1] - bx[k] );
         }
     }
-    
+
     // Electric field Ez^(p,p,d)
-    for (unsigned int i=0 ;  i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            for (unsigned int k=0 ; k<nz_d ; k++) {
-                (*Ez3D)(i,j,k) += -dt*(*Jz3D)(i,j,k)
-                +                  dt_ov_dx * ( (*By3D)(i+1,j,k) - (*By3D)(i,j,k) )
-                -                  dt_ov_dy * ( (*Bx3D)(i,j+1,k) - (*Bx3D)(i,j,k) );
-            }
+    for (unsigned int j=j0 ; j<std::min(j1,ny_p) ; j++) {
+        double*       ez  = Ez + (i*ny_p + j)*nz_d;
+        const double* jz  = Jz + (i*ny_p + j)*nz_d;
+        const double* bx  = Bx + (i*ny_d + j)*nz_d;
+        const double* bxp = bx + nz_d;
+        const double* by  = By + (i*ny_p + j)*nz_d;
+        const double* byp = by + ny_p*nz_d;
+        #pragma omp simd
+        for (unsigned int k=0 ; k<nz_d ; k++) {
+            ez[k] += -dt*jz[k]
+            +        dt_ov_dx * ( byp[k] - by[k] )
+            -        dt_ov_dy * ( bxp[k] - bx[k] );
         }
     }
 
@@ -1,6 +1,8 @@
 
 #include "MF_Solver3D_Yee.h"
 
+#include <algorithm>
+
 #include "ElectroMagn.h"
 #include "Field3D.h"
 
@@ -13,40 +15,73 @@ MF_Solver3D_Yee::~MF_Solver3D_Yee()
 {
 }
 
+// Cache blocks : one x-plane of tile_y rows, in which Bx, By and Bz are updated one after the other.
+// The x-plane i-1 of E is still in cache when the plane i is computed.
 void MF_Solver3D_Yee::operator() ( ElectroMagn* fields )
 {
-    // Static-cast of the fields
-    Field3D* Ex3D = static_cast<Field3D*>(fields->Ex_);
-    Field3D* Ey3D = static_cast<Field3D*>(fields->Ey_);
-    Field3D* Ez3D = static_cast<Field3D*>(fields->Ez_);
-    Field3D* Bx3D = static_cast<Field3D*>(fields->Bx_);
-    Field3D* By3D = static_cast<Field3D*>(fields->By_);
-    Field3D* Bz3D = static_cast<Field3D*>(fields->Bz_);
-    
+    for (unsigned int j0=0 ; j0<ny_d ; j0+=tile_y) {
+        unsigned int j1 = std::min( j0+tile_y, ny_d );
+        for (unsigned int i=0 ; i<nx_d ; i++)
+            plane( fields, i, j0, j1 );
+    }
+}
+
+
+// The z direction, contiguous in memory, is the vectorized inner loop
+void MF_Solver3D_Yee::plane( ElectroMagn* fields, unsigned int i, unsigned int j0, unsigned int j1 )
+{
+    const double* Ex = fields->Ex_->data_;
+    const double* Ey = fields->Ey_->data_;
+    const double* Ez = fields->Ez_->data_;
+    double* Bx = fields->Bx_->data_;
+    double* By = fields->By_->data_;
+    double* Bz = fields->Bz_->data_;
+
+    // Local copies : the compiler can not assume that the fields do not alias the members
+    const unsigned int nx_p = this->nx_p, nx_d = this->nx_d;
+    const unsigned int ny_p = this->ny_p, ny_d = this->ny_d;
+    const unsigned int nz_p = this->nz_p, nz_d = this->nz_d;
+    const double dt_ov_dx = this->dt_ov_dx, dt_ov_dy = this->dt_ov_dy, dt_ov_dz = this->dt_ov_dz;
+
     // Magnetic field Bx^(p,d,d)
-    for (unsigned int i=0 ; i<nx_p;  i++) {
-        for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+    if ( i<nx_p ) {
+        for (unsigned int j=std::max(j0,1u) ; j<std::min(j1,ny_d-1) ; j++) {
+            double*       bx  = Bx + (i*ny_d + j)*nz_d;
+            const double* ey  = Ey + (i*ny_d + j)*nz_p;
+            const double* ez  = Ez + (i*ny_p + j)*nz_d;
+            const double* ezm = ez - nz_d;
+            #pragma omp simd
             for (unsigned int k=1 ; k<nz_d-1 ; k++) {
-                (*Bx3D)(i,j,k) += -dt_ov_dy * ( (*Ez3D)(i,j,k) - (*Ez3D)(i,j-1,k) ) + dt_ov_dz * ( (*Ey3D)(i,j,k) - (*Ey3D)(i,j,k-1) );
+                bx[k] += -dt_ov_dy * ( ez[k] - ezm[k] ) + dt_ov_dz * ( ey[k] - ey[k-1] );
             }
         }
     }
-        
+
+    if ( (i<1) || (i>=nx_d-1) )
+        return;
+
     // Magnetic field By^(d,p,d)
-    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            for (unsigned int k=1 ; k<nz_d-1 ; k++) {
-                (*By3D)(i,j,k) += -dt_ov_dz * ( (*Ex3D)(i,j,k) - (*Ex3D)(i,j,k-1) ) + dt_ov_dx * ( (*Ez3D)(i,j,k) - (*Ez3D)(i-1,j,k) );
-            }
+    for (unsigned int j=j0 ; j<std::min(j1,ny_p) ; j++) {
+        double*       by  = By + (i*ny_p + j)*nz_d;
+        const double* ex  = Ex + (i*ny_p + j)*nz_p;
+        const double* ez  = Ez + (i*ny_p + j)*nz_d;
+        const double* ezm = ez - ny_p*nz_d;
+        #pragma omp simd
+        for (unsigned int k=1 ; k<nz_d-1 ; k++) {
+            by[k] += -dt_ov_dz * ( ex[k] - ex[k-1] ) + dt_ov_dx * ( ez[k] - ezm[k] );
         }
     }
-        
+
     // Magnetic field Bz^(d,d,p)
-    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
-        for (unsigned int j=1 ; j<ny_d-1 ; j++) {
-            for (unsigned int k=0 ; k<nz_p ; k++) {
-                (*Bz3D)(i,j,k) += -dt_ov_dx * ( (*Ey3D)(i,j,k) - (*Ey3D)(i-1,j,k) ) + dt_ov_dy * ( (*Ex3D)(i,j,k) - (*Ex3D)(i,j-1,k) );
-            }
+    for (unsigned int j=std::max(j0,1u) ; j<std::min(j1,ny_d-1) ; j++) {
+        double*       bz  = Bz + (i*ny_d + j)*nz_p;
+        const double* ex  = Ex + (i*ny_p + j)*nz_p;
+        const double* exm = ex - nz_p;
+        const double* ey  = Ey + (i*ny_d + j)*nz_p;
+        const double* eym = ey - ny_d*nz_p;
+        #pragma omp simd
+        for (unsigned int k=0 ; k<nz_p ; k++) {
+            bz[k] += -dt_ov_dx * ( ey[k] - eym[k] ) + dt_ov_dy * ( ex[k] - exm[k] );
         }
     }
 
@@ -18,6 +18,9 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn* fields);
 
+    //! Update of Bx, By and Bz in the cache block made of the rows j0 to j1-1 of the x-plane i
+    void plane( ElectroMagn* fields, unsigned int i, unsigned int j0, unsigned int j1 );
+
 protected:
 
 };//END class
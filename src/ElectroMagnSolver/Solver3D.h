@@ -24,6 +24,9 @@ public:
 	dt_ov_dy = params.timestep / params.cell_length[1];
 	dt_ov_dz = params.timestep / params.cell_length[2];
 
+        // Two x-planes of a block of the 6 components of E and B fit in 256 kB
+        tile_y = 32768 / (12*nz_d);
+        if (tile_y==0) tile_y = 1;
     };
     virtual ~Solver3D() {};
 
@@ -42,6 +45,9 @@ protected:
     double dt_ov_dy;
     double dt_ov_dz;
 
+    //! Number of cells along y of the cache blocks of the Yee solvers
+    unsigned int tile_y;
+
 };//END class
 
 #endif
@@ -13,6 +13,7 @@
 #include "MF_Solver2D_Cowan.h"
 #include "MF_Solver2D_Lehe.h"
 #include "MF_Solver3D_Lehe.h"
+#include "MAMF_Solver3D_Yee.h"
 
 #include "PXR_Solver2D_GPSTD.h"
 #include "PXR_Solver3D_FDTD.h"
@@ -114,6 +115,17 @@ public:
         return solver;
     };
     
+    // Create the fused Maxwell solver (NULL if not requested)
+    // -------------------------------------------------------
+    static Solver* createFused(Params& params) {
+        Solver* solver = NULL;
+        
+        if ( params.fused_field_step )
+            solver = new MAMF_Solver3D_Yee(params);
+        
+        return solver;
+    };
+    
 };
 
 #endif
@@ -11,6 +11,7 @@
 
 #include "Tools.h"
 #include "AsyncMPIbuffers.h"
+#include "FieldArena.h"
 
 class Params;
 class SmileiMPI;
@@ -38,22 +39,22 @@ public:
     std::string name;
     
     //! Constructor for Field: with no input argument
-    Field() {
+    Field() : in_arena_(false) {
     };
     
     //! Constructor for Field: with the Field dimensions as input argument
-    Field( std::vector<unsigned int> dims ) {
+    Field( std::vector<unsigned int> dims ) : in_arena_(false) {
     };
     //! Constructor, isPrimal define if mainDim is Primal or Dual
-    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal ) {
+    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal ) : in_arena_(false) {
     };
     
     //! Constructor for Field: with the Field dimensions and dump file name as input argument
-    Field( std::vector<unsigned int> dims, std::string name_in ) : name(name_in) {
+    Field( std::vector<unsigned int> dims, std::string name_in ) : name(name_in), in_arena_(false) {
     } ;
     
     //! Constructor for Field: isPrimal define if mainDim is Primal or Dual
-    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal, std::string name_in ) : name(name_in) {
+    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal, std::string name_in ) : name(name_in), in_arena_(false) {
     } ;
     
     //! Destructor for Field
@@ -100,6 +101,18 @@ public:
     unsigned int globalDims_;
     //! pointer to the linearized array
     double* data_;
+    //! data_ (and the row pointers in 2D and 3D) carved from a FieldArena, which owns them
+    bool in_arena_;
+    
+    //! Bytes taken in a FieldArena by a field of dimensions dims : data, then row pointers in 2D and 3D
+    static std::size_t arenaSize( std::vector<unsigned int> dims ) {
+        std::size_t n = 1, size = 0;
+        for ( unsigned int i=0 ; i<dims.size() ; i++ ) {
+            if ( i>0 ) size += FieldArena::size<double*>( n );
+            n *= dims[i];
+        }
+        return size + FieldArena::size<double>( n );
+    }
     
     inline double* data() {return data_;}
     //! reference access to the linearized array (with check in DEBUG mode)
@@ -57,9 +57,33 @@ Field1D::Field1D(string name, vector<unsigned int> dims) : Field(dims, name)
 // ---------------------------------------------------------------------------------------------------------------------
 Field1D::~Field1D()
 {
-    if (data_!=NULL) {
-        delete [] data_;
+    if (data_!=NULL) freeData();
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Allocation of the data for dims_, in the FieldArena of the thread if it has room
+// ---------------------------------------------------------------------------------------------------------------------
+void Field1D::allocateData()
+{
+    in_arena_ = FieldArena::current && FieldArena::current->fits( arenaSize(dims_) );
+    if (in_arena_) {
+        // Already zero : the data are not touched here, so that they are first touched by the thread owning the patch
+        data_ = FieldArena::current->takeData( dims_[0] );
+    } else {
+        data_ = new double[ dims_[0] ];
+        memset( data_, 0, dims_[0]*sizeof(double) );
     }
+    
+    globalDims_ = dims_[0];
+}
+
+void Field1D::freeData()
+{
+    if (!in_arena_)
+        delete [] data_;
+    data_ = NULL;
+    in_arena_ = false;
 }
 
 
@@ -73,18 +97,13 @@ void Field1D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[ dims_[0] ];
-    //! \todo{change to memset (JD)}
-    for (unsigned int i=0; i<dims_[0]; i++) data_[i]=0.0;
-    
-    globalDims_ = dims_[0];
+    allocateData();
 
 }
 
 void Field1D::deallocateDims()
 {
-    delete [] data_;
-    data_=NULL;
+    freeData();
 }
 
 
@@ -117,11 +136,7 @@ void Field1D::allocateDims(unsigned int mainDim, bool isPrimal)
     for ( unsigned int j=0 ; j<dims_.size() ; j++ )
         dims_[j] += isDual_[j];
     
-    data_ = new double[ dims_[0] ];
-    //! \todo{change to memset (JD)}
-    for (unsigned int i=0; i<dims_[0]; i++) data_[i]=0.0;
-    
-    globalDims_ = dims_[0];
+    allocateData();
 
 }
 
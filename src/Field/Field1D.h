@@ -88,6 +88,9 @@ public:
     void get( Field*  inField, Params &params, SmileiMPI* smpi, Patch*   inPatch, Patch* thisPatch ) override;
     
 private:
+    //! Allocate data_ for dims_, in the FieldArena of the thread if any
+    void allocateData();
+    void freeData();
 };
 
 
@@ -64,10 +64,44 @@ Field2D::Field2D(string name, vector<unsigned int> dims) : Field(dims, name)
 Field2D::~Field2D()
 {
 
-    if (data_!=NULL) {
+    if (data_!=NULL) freeData();
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Allocation of the data and of the row pointers for dims_, in the FieldArena of the thread if it has room
+// ---------------------------------------------------------------------------------------------------------------------
+void Field2D::allocateData()
+{
+    unsigned int size = dims_[0]*dims_[1];
+    
+    in_arena_ = FieldArena::current && FieldArena::current->fits( arenaSize(dims_) );
+    if (in_arena_) {
+        // Already zero : the data are not touched here, so that they are first touched by the thread owning the patch
+        data_   = FieldArena::current->takeData( size );
+        data_2D = FieldArena::current->takePointers<double*>( dims_[0] );
+    } else {
+        data_   = new double[size];
+        data_2D = new double*[dims_[0]];
+        memset( data_, 0, size*sizeof(double) );
+    }
+    
+    //! \todo{check row major order!!! (JD)}
+    for (unsigned int i=0; i<dims_[0]; i++)
+        data_2D[i] = data_ + i*dims_[1];
+    
+    globalDims_ = size;
+}
+
+void Field2D::freeData()
+{
+    if (data_ && !in_arena_) {
         delete [] data_;
         delete [] data_2D;
     }
+    data_ = NULL;
+    data_2D = NULL;
+    in_arena_ = false;
 }
 
 
@@ -78,30 +112,17 @@ void Field2D::allocateDims()
 {
     //! \todo{Comment on what you are doing here (MG for JD)}
     if (dims_.size()!=2) ERROR("Alloc error must be 2 : " << dims_.size());
-    if (data_!=NULL) delete [] data_;
+    if (data_!=NULL) freeData();
 
     isDual_.resize( dims_.size(), 0 );
 
-    data_ = new double[dims_[0]*dims_[1]];
-    //! \todo{check row major order!!! (JD)}
-
-    data_2D= new double*[dims_[0]];
-    for (unsigned int i=0; i<dims_[0]; i++) {
-        data_2D[i] = data_ + i*dims_[1];
-        for (unsigned int j=0; j<dims_[1]; j++) data_2D[i][j] = 0.0;
-    }
-
-    globalDims_ = dims_[0]*dims_[1];
+    allocateData();
 
 }
 
 void Field2D::deallocateDims()
 {
-    delete [] data_;
-    data_ = NULL;
-    delete [] data_2D;
-    data_2D = NULL;
-        
+    freeData();
 }
 
 void Field2D::allocateDims(unsigned int dims1, unsigned int dims2)
@@ -119,7 +140,7 @@ void Field2D::allocateDims(unsigned int mainDim, bool isPrimal )
 {
     //! \todo{Comment on what you are doing here (MG for JD)}
     if (dims_.size()!=2) ERROR("Alloc error must be 2 : " << dims_.size());
-    if (data_) delete [] data_;
+    if (data_) freeData();
     
     // isPrimal define if mainDim is Primal or Dual
     isDual_.resize( dims_.size(), 0 );
@@ -133,16 +154,7 @@ void Field2D::allocateDims(unsigned int mainDim, bool isPrimal )
     for ( unsigned int j=0 ; j<dims_.size() ; j++ )
         dims_[j] += isDual_[j];
     
-    data_ = new double[dims_[0]*dims_[1]];
-    //! \todo{check row major order!!! (JD)}
-    
-    data_2D= new double*[dims_[0]];
-    for (unsigned int i=0; i<dims_[0]; i++)  {
-        data_2D[i] = data_ + i*dims_[1];
-        for (unsigned int j=0; j<dims_[1]; j++) data_2D[i][j] = 0.0;
-    }
-    
-    globalDims_ = dims_[0]*dims_[1];
+    allocateData();
     
 }
 
@@ -94,6 +94,11 @@ public:
     //! this will present the data as a 2d matrix
     double **data_2D;
     
+private:
+    //! Allocate data_ and data_2D for dims_, in the FieldArena of the thread if any
+    void allocateData();
+    void freeData();
+    
 };
 
 #endif
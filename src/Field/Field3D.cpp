@@ -64,49 +64,72 @@ Field3D::Field3D(string name, vector<unsigned int> dims) : Field(dims, name)
 // ---------------------------------------------------------------------------------------------------------------------
 Field3D::~Field3D()
 {
-    if (data_!=NULL) {
-        delete [] data_;
-        for (unsigned int i=0; i<dims_[0]; i++) delete [] data_3D[i];
-        delete [] data_3D;
-    }
+    if (data_!=NULL) freeData();
 }
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Method used for allocating the dimension of a Field3D
+// Allocation of the data and of the row pointers for dims_, in the FieldArena of the thread if it has room
 // ---------------------------------------------------------------------------------------------------------------------
-void Field3D::allocateDims() {
-    if (dims_.size()!=3) ERROR("Alloc error must be 3 : " << dims_.size());
-    if (data_) delete [] data_;
+void Field3D::allocateData()
+{
+    unsigned int size = dims_[0]*dims_[1]*dims_[2];
     
-    isDual_.resize( dims_.size(), 0 );
+    in_arena_ = FieldArena::current && FieldArena::current->fits( arenaSize(dims_) );
+    if (in_arena_) {
+        // Already zero : the data are not touched here, so that they are first touched by the thread owning the patch
+        data_   = FieldArena::current->takeData( size );
+        data_3D = FieldArena::current->takePointers<double**>( dims_[0] );
+        rows_   = FieldArena::current->takePointers<double*>( dims_[0]*dims_[1] );
+    } else {
+        data_   = new double[size];
+        data_3D = new double**[dims_[0]];
+        rows_   = new double*[dims_[0]*dims_[1]];
+        memset( data_, 0, size*sizeof(double) );
+    }
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
     //! \todo{check row major order!!!}
-    data_3D= new double**[dims_[0]];
     for (unsigned int i=0; i<dims_[0]; i++)
     {
-        data_3D[i]= new double*[dims_[1]];
+        data_3D[i] = rows_ + i*dims_[1];
         for (unsigned int j=0; j<dims_[1]; j++)
-        {
             data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
-            for (unsigned int k=0; k<dims_[2]; k++) data_3D[i][j][k] = 0.0;
-        }
     }//i
     
     //DEBUG(10,"Fields 3D created: " << dims_[0] << "x" << dims_[1] << "x" << dims_[2]);
-    globalDims_ = dims_[0]*dims_[1]*dims_[2];
-
+    globalDims_ = size;
 }
 
-void Field3D::deallocateDims()
+void Field3D::freeData()
 {
-    delete [] data_;
+    if (data_ && !in_arena_) {
+        delete [] data_;
+        delete [] rows_;
+        delete [] data_3D;
+    }
     data_ = NULL;
-    for (unsigned int i=0; i<dims_[0]; i++) delete [] data_3D[i];
-    delete [] data_3D;
     data_3D = NULL;
+    rows_ = NULL;
+    in_arena_ = false;
+}
+
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Method used for allocating the dimension of a Field3D
+// ---------------------------------------------------------------------------------------------------------------------
+void Field3D::allocateDims() {
+    if (dims_.size()!=3) ERROR("Alloc error must be 3 : " << dims_.size());
+    if (data_) freeData();
+    
+    isDual_.resize( dims_.size(), 0 );
+    
+    allocateData();
+
+}
+
+void Field3D::deallocateDims()
+{
+    freeData();
 }
 
 
@@ -125,7 +148,7 @@ void Field3D::allocateDims(unsigned int dims1, unsigned int dims2, unsigned int
 // ---------------------------------------------------------------------------------------------------------------------
 void Field3D::allocateDims(unsigned int mainDim, bool isPrimal ) {
     if (dims_.size()!=3) ERROR("Alloc error must be 3 : " << dims_.size());
-    if (data_) delete [] data_;
+    if (data_) freeData();
     
     // isPrimal define if mainDim is Primal or Dual
     isDual_.resize( dims_.size(), 0 );
@@ -139,21 +162,7 @@ void Field3D::allocateDims(unsigned int mainDim, bool isPrimal ) {
     for ( unsigned int j=0 ; j<dims_.size() ; j++ )
         dims_[j] += isDual_[j];
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
-    //! \todo{check row major order!!!}
-    data_3D= new double**[dims_[0]*dims_[1]];
-    for (unsigned int i=0; i<dims_[0]; i++)
-    {
-        data_3D[i]= new double*[dims_[1]];
-        for (unsigned int j=0; j<dims_[1]; j++)
-        {
-            data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
-            for (unsigned int k=0; k<dims_[2]; k++) data_3D[i][j][k] = 0.0;
-        }
-    }//i
-    
-    //DEBUG(10,"Fields 3D created: " << dims_[0] << "x" << dims_[1] << "x" << dims_[2]);
-    globalDims_ = dims_[0]*dims_[1]*dims_[2];
+    allocateData();
 
     //isDual_ = isPrimal;
 }
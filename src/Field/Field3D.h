@@ -98,6 +98,14 @@ public:
     //! this will present the data as a 3d matrix
     double ***data_3D;
     
+private:
+    //! Allocate data_ and data_3D for dims_, in the FieldArena of the thread if any
+    void allocateData();
+    void freeData();
+    
+    //! Pointers to the rows of all the x-planes, pointed by data_3D
+    double **rows_;
+    
 };
 
 #endif
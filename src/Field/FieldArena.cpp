@@ -0,0 +1,126 @@
+#include "FieldArena.h"
+
+#include <fcntl.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Tools.h"
+
+using namespace std;
+
+thread_local FieldArena* FieldArena::current = NULL;
+
+string FieldArena::shared_prefix_;
+int FieldArena::shared_rank_ = 0;
+atomic<unsigned int> FieldArena::last_serial_( 0 );
+map< pair<int, unsigned int>, pair<char*, size_t> > FieldArena::attached_;
+
+FieldArena::FieldArena() :
+    base_( NULL ),
+    capacity_( 0 ),
+    front_( 0 ),
+    back_( 0 ),
+    serial_( 0 )
+{
+}
+
+FieldArena::~FieldArena()
+{
+    release();
+}
+
+// The name of a shared arena is removed with it : the MPI processes which attached it keep their mapping
+void FieldArena::release()
+{
+    if ( base_ )
+        munmap( base_, capacity_ );
+    if ( serial_ )
+        shm_unlink( sharedName( shared_rank_, serial_ ).c_str() );
+    base_   = NULL;
+    serial_ = 0;
+}
+
+void FieldArena::allocate( size_t size, bool huge_pages, bool shared )
+{
+    release();
+
+    // Anonymous mappings are page aligned, and their pages are zeroed at the first touch
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    int fd = -1;
+    // So are the pages of a shared memory object
+    if ( shared ) {
+        serial_ = ++last_serial_;
+        string name = sharedName( shared_rank_, serial_ );
+        fd = shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR );
+        if ( fd < 0 || ftruncate( fd, size ) != 0 )
+            ERROR( "Cannot create the shared field arena " << name << " of " << size << " bytes" );
+        flags = MAP_SHARED;
+    }
+    void* map = mmap( NULL, size, PROT_READ | PROT_WRITE, flags, fd, 0 );
+    if ( fd >= 0 )
+        close( fd );
+    if ( map == MAP_FAILED )
+        ERROR( "Cannot map the field arena of " << size << " bytes" );
+#ifdef MADV_HUGEPAGE
+    if ( huge_pages )
+        madvise( map, size, MADV_HUGEPAGE );
+#endif
+
+    base_     = static_cast<char*>( map );
+    capacity_ = size;
+    front_    = 0;
+    back_     = size / alignment * alignment;
+}
+
+double* FieldArena::takeData( size_t n )
+{
+    double* data = reinterpret_cast<double*>( base_ + front_ );
+    front_ += size<double>( n );
+    return data;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Shared arenas (Main.shared_memory_exchanges)
+// ---------------------------------------------------------------------------------------------------------------------
+void FieldArena::share( const string& prefix, int rank )
+{
+    shared_prefix_ = prefix;
+    shared_rank_   = rank;
+}
+
+string FieldArena::sharedName( int rank, unsigned int serial )
+{
+    ostringstream name;
+    name << shared_prefix_ << rank << "-" << serial;
+    return name.str();
+}
+
+const char* FieldArena::attach( int rank, unsigned int serial )
+{
+    pair<char*, size_t>& mapping = attached_[ make_pair( rank, serial ) ];
+    if ( mapping.first )
+        return mapping.first;
+
+    string name = sharedName( rank, serial );
+    int fd = shm_open( name.c_str(), O_RDONLY, 0 );
+    struct stat st;
+    if ( fd < 0 || fstat( fd, &st ) != 0 )
+        ERROR( "Cannot open the shared field arena " << name );
+    void* map = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( map == MAP_FAILED )
+        ERROR( "Cannot map the shared field arena " << name );
+
+    mapping = make_pair( static_cast<char*>( map ), (size_t) st.st_size );
+    return mapping.first;
+}
+
+void FieldArena::detachAll()
+{
+    for ( map< pair<int, unsigned int>, pair<char*, size_t> >::iterator it=attached_.begin() ; it!=attached_.end() ; it++ )
+        if ( it->second.first )
+            munmap( it->second.first, it->second.second );
+    attached_.clear();
+}
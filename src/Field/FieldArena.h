@@ -0,0 +1,84 @@
+#ifndef FIELDARENA_H
+#define FIELDARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+
+//! Single allocation holding all the fields of a patch (Main.field_arena), in which the fields are carved
+//! at their creation instead of being allocated one by one. The data of the fields are taken from the start,
+//! 64-byte aligned, and the row pointers of Field2D and Field3D from the end.
+//! The memory is mapped on demand and zero : its pages are placed on the NUMA node of the thread which first
+//! writes the data, i.e. the thread which owns the patch in the static OpenMP loops, not the thread which
+//! creates the patch.
+//! A shared arena (Main.shared_memory_exchanges) is a POSIX shared memory object, that the other MPI processes
+//! of the node map (attach) to read the ghost cells of the fields directly.
+class FieldArena {
+public:
+    FieldArena();
+    ~FieldArena();
+
+    //! Map size bytes, on transparent huge pages if huge_pages (where available), shared with the node if shared
+    void allocate( std::size_t size, bool huge_pages, bool shared );
+
+    //! Bytes taken in the arena by an array of n elements of type T
+    template<typename T>
+    static std::size_t size( std::size_t n ) {
+        return ( n*sizeof(T) + alignment-1 ) / alignment * alignment;
+    }
+
+    //! Whether size bytes are still available
+    inline bool fits( std::size_t size ) {
+        return front_ + size <= back_;
+    }
+
+    //! Zero array of n doubles, for the data of a field
+    double* takeData( std::size_t n );
+    //! Array of n pointers, for the row pointers of a field
+    template<typename T>
+    T* takePointers( std::size_t n ) {
+        back_ -= size<T>( n );
+        return reinterpret_cast<T*>( base_ + back_ );
+    }
+
+    //! Position of p in the arena : identical for the same field in all the patches, carved in the same order
+    inline std::size_t offset( const void* p ) const {
+        return static_cast<const char*>( p ) - base_;
+    }
+    //! Number of a shared arena, unique in its MPI process (0 if not shared)
+    inline unsigned int serial() const {
+        return serial_;
+    }
+
+    //! Arena in which the fields created by the calling thread are carved (NULL : fields allocated on the heap)
+    static thread_local FieldArena* current;
+
+    static const std::size_t alignment = 64;
+
+    //! Names of the shared arenas of this MPI process : prefix identical for the node, then rank and serial
+    static void share( const std::string& prefix, int rank );
+    //! Map (read only) the shared arena serial of the MPI process rank of the node. Mappings are kept until detachAll
+    static const char* attach( int rank, unsigned int serial );
+    //! Unmap all the arenas of the other MPI processes
+    static void detachAll();
+
+private:
+    char* base_;
+    std::size_t capacity_;
+    //! Limits of the free space
+    std::size_t front_, back_;
+    unsigned int serial_;
+
+    void release();
+
+    static std::string sharedName( int rank, unsigned int serial );
+    static std::string shared_prefix_;
+    static int shared_rank_;
+    static std::atomic<unsigned int> last_serial_;
+    //! Arenas of the other MPI processes, by rank and serial : address and size
+    static std::map< std::pair<int, unsigned int>, std::pair<char*, std::size_t> > attached_;
+};
+
+#endif
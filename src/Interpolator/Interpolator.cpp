@@ -5,10 +5,18 @@
 
 #include "Params.h"
 #include "Patch.h"
+#include "Tools.h"
 
 using namespace std;
 
+const int Interpolator::block_size;
+
 Interpolator::Interpolator(Params &params, Patch* patch)
 {
 }
 
+void Interpolator::interpolate_chunk(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nchunk, double* Epart, double* Bpart, int* iold, double* delta)
+{
+    ERROR("Fused dynamics not available for this interpolator");
+}
+
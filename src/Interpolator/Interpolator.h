@@ -23,6 +23,13 @@ public:
     virtual void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc, LocalFields* JLoc, double* RhoLoc) = 0;
     virtual void operator() (ElectroMagn* EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> * selection) = 0;
 
+    //! Interpolate a chunk of particles in buffers of size nchunk indexed from istart (fused dynamics)
+    virtual void interpolate_chunk(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nchunk, double* Epart, double* Bpart, int* iold, double* delta);
+
+protected:
+    //! Number of particles interpolated together by the block-wise (vectorized) wrappers
+    static const int block_size = 32;
+
 private:
 
 };//END class
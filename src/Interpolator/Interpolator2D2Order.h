@@ -20,6 +20,7 @@ public:
     void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int *istart, int *iend, int ithread) override final ;
     void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, LocalFields* ELoc, LocalFields* BLoc, LocalFields* JLoc, double* RhoLoc) override final ;
     void operator() (ElectroMagn* EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> * selection) override final;
+    void interpolate_chunk(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nchunk, double* Epart, double* Bpart, int* iold, double* delta) override final;
 
     inline double compute( double* coeffx, double* coeffy, Field2D* f, int idx, int idy) {
         double interp_res(0.);
@@ -32,7 +33,26 @@ public:
         return interp_res;
     };  
 
+    //! Same as compute for a block of np particles, coefficients stored as coeff[node][particle]
+    inline void compute_block( double (*coeffx)[block_size], double (*coeffy)[block_size], Field2D* f, int* idx, int* idy, int np, double* res ) {
+        double* data = f->data_;
+        int ny = f->dims_[1];
+        #pragma omp simd
+        for (int i=0 ; i<np ; i++) {
+            double interp_res(0.);
+            for (int iloc=-1 ; iloc<2 ; iloc++) {
+                for (int jloc=-1 ; jloc<2 ; jloc++) {
+                    interp_res += coeffx[iloc+1][i] * coeffy[jloc+1][i] * data[ (idx[i]+iloc)*ny + idy[i]+jloc ];
+                }
+            }
+            res[i] = interp_res;
+        }
+    };
+
 private:
+    //! Interpolation of the particles [istart,iend[ (at most block_size) with stack-local coefficients, buffers of stride nparts indexed from istart
+    void interpolate_block(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta);
+
     // Last prim index computed
     int ip_, jp_;
     // Last dual index computed
@@ -31,7 +31,26 @@ public:
         return interp_res;
     };
 
+    //! Same as compute for a block of np particles, coefficients stored as coeff[node][particle]
+    inline void compute_block( double (*coeffx)[block_size], double (*coeffy)[block_size], Field2D* f, int* idx, int* idy, int np, double* res ) {
+        double* data = f->data_;
+        int ny = f->dims_[1];
+        #pragma omp simd
+        for (int i=0 ; i<np ; i++) {
+            double interp_res(0.);
+            for (int iloc=-2 ; iloc<3 ; iloc++) {
+                for (int jloc=-2 ; jloc<3 ; jloc++) {
+                    interp_res += coeffx[iloc+2][i] * coeffy[jloc+2][i] * data[ (idx[i]+iloc)*ny + idy[i]+jloc ];
+                }
+            }
+            res[i] = interp_res;
+        }
+    };
+
 private:
+    //! Interpolation of the particles [istart,iend[ (at most block_size) with stack-local coefficients, buffers of stride nparts indexed from istart
+    void interpolate_block(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta);
+
     double dble_1_ov_384 ;
     double dble_1_ov_48 ;
     double dble_1_ov_16 ;
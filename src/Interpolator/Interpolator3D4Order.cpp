@@ -332,23 +332,15 @@ void Interpolator3D4Order::operator() (ElectroMagn* EMfields, Particles &particl
 
 void Interpolator3D4Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int *istart, int *iend, int ithread)
 {
-    std::vector<double> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<double> *Bpart = &(smpi->dynamics_Bpart[ithread]);
-    std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
-    std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
+    double *Epart = smpi->dynamics_Epart[ithread].data();
+    double *Bpart = smpi->dynamics_Bpart[ithread].data();
+    int    *iold  = smpi->dynamics_iold[ithread].data();
+    double *delta = smpi->dynamics_deltaold[ithread].data();
 
-    //Loop on bin particles
+    //Loop on bin particles, block by block
     int nparts( particles.size() );
-    for (int ipart=*istart ; ipart<*iend; ipart++ ) {
-        //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, nparts, &(*Epart)[ipart], &(*Bpart)[ipart]);
-        //Buffering of iol and delta
-        (*iold)[ipart+0*nparts]  = ip_;
-        (*iold)[ipart+1*nparts]  = jp_;
-        (*iold)[ipart+2*nparts]  = kp_;
-        (*delta)[ipart+0*nparts] = deltax;
-        (*delta)[ipart+1*nparts] = deltay;
-        (*delta)[ipart+2*nparts] = deltaz;
+    for (int ipart=*istart ; ipart<*iend; ipart+=block_size ) {
+        interpolate_block(EMfields, particles, ipart, min(ipart+block_size, *iend), nparts, &Epart[ipart], &Bpart[ipart], &iold[ipart], &delta[ipart]);
     }
 
 }
@@ -374,4 +366,128 @@ void Interpolator3D4Order::operator() (ElectroMagn* EMfields, Particles &particl
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Interpolation of a block of at most block_size particles : indexes and coefficients are computed for the whole block
+// in stack arrays, then each field component is gathered particle-wise, both loops being vectorized
+// ---------------------------------------------------------------------------------------------------------------------
+void Interpolator3D4Order::interpolate_block(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nparts, double* Epart, double* Bpart, int* iold, double* delta)
+{
+    // Static cast of the electromagnetic fields
+    Field3D* Ex3D = static_cast<Field3D*>(EMfields->Ex_);
+    Field3D* Ey3D = static_cast<Field3D*>(EMfields->Ey_);
+    Field3D* Ez3D = static_cast<Field3D*>(EMfields->Ez_);
+    Field3D* Bx3D = static_cast<Field3D*>(EMfields->Bx_m);
+    Field3D* By3D = static_cast<Field3D*>(EMfields->By_m);
+    Field3D* Bz3D = static_cast<Field3D*>(EMfields->Bz_m);
+
+    int np = iend-istart;
+    double* position_x = &( particles.position(0, istart) );
+    double* position_y = &( particles.position(1, istart) );
+    double* position_z = &( particles.position(2, istart) );
+
+    // Indexes of the central nodes and interpolation coefficients of the particles of the block
+    int ip[block_size], id[block_size], jp[block_size], jd[block_size], kp[block_size], kd[block_size];
+    double coeffxp[5][block_size], coeffxd[5][block_size];
+    double coeffyp[5][block_size], coeffyd[5][block_size];
+    double coeffzp[5][block_size], coeffzd[5][block_size];
+
+    #pragma omp simd
+    for (int i=0 ; i<np ; i++) {
+        // Normalized particle position
+        double xpn = position_x[i]*dx_inv_;
+        double ypn = position_y[i]*dy_inv_;
+        double zpn = position_z[i]*dz_inv_;
+        double delta2, delta3, delta4;
+
+        int ip_i = Tools::round_index(xpn);
+        int id_i = Tools::round_index(xpn+0.5);
+        double deltaxd = xpn - (double)id_i + 0.5;
+        delta2 = deltaxd*deltaxd;
+        delta3 = delta2*deltaxd;
+        delta4 = delta3*deltaxd;
+        coeffxd[0][i] = dble_1_ov_384   - dble_1_ov_48  * deltaxd  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        coeffxd[1][i] = dble_19_ov_96   - dble_11_ov_24 * deltaxd  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffxd[2][i] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+        coeffxd[3][i] = dble_19_ov_96   + dble_11_ov_24 * deltaxd  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffxd[4][i] = dble_1_ov_384   + dble_1_ov_48  * deltaxd  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        double deltaxp = xpn - (double)ip_i;
+        delta2 = deltaxp*deltaxp;
+        delta3 = delta2*deltaxp;
+        delta4 = delta3*deltaxp;
+        coeffxp[0][i] = dble_1_ov_384   - dble_1_ov_48  * deltaxp  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        coeffxp[1][i] = dble_19_ov_96   - dble_11_ov_24 * deltaxp  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffxp[2][i] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+        coeffxp[3][i] = dble_19_ov_96   + dble_11_ov_24 * deltaxp  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffxp[4][i] = dble_1_ov_384   + dble_1_ov_48  * deltaxp  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        ip[i] = ip_i - i_domain_begin;
+        id[i] = id_i - i_domain_begin;
+
+        int jp_i = Tools::round_index(ypn);
+        int jd_i = Tools::round_index(ypn+0.5);
+        double deltayd = ypn - (double)jd_i + 0.5;
+        delta2 = deltayd*deltayd;
+        delta3 = delta2*deltayd;
+        delta4 = delta3*deltayd;
+        coeffyd[0][i] = dble_1_ov_384   - dble_1_ov_48  * deltayd  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        coeffyd[1][i] = dble_19_ov_96   - dble_11_ov_24 * deltayd  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffyd[2][i] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+        coeffyd[3][i] = dble_19_ov_96   + dble_11_ov_24 * deltayd  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffyd[4][i] = dble_1_ov_384   + dble_1_ov_48  * deltayd  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        double deltayp = ypn - (double)jp_i;
+        delta2 = deltayp*deltayp;
+        delta3 = delta2*deltayp;
+        delta4 = delta3*deltayp;
+        coeffyp[0][i] = dble_1_ov_384   - dble_1_ov_48  * deltayp  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        coeffyp[1][i] = dble_19_ov_96   - dble_11_ov_24 * deltayp  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffyp[2][i] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+        coeffyp[3][i] = dble_19_ov_96   + dble_11_ov_24 * deltayp  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffyp[4][i] = dble_1_ov_384   + dble_1_ov_48  * deltayp  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        jp[i] = jp_i - j_domain_begin;
+        jd[i] = jd_i - j_domain_begin;
+
+        int kp_i = Tools::round_index(zpn);
+        int kd_i = Tools::round_index(zpn+0.5);
+        double deltazd = zpn - (double)kd_i + 0.5;
+        delta2 = deltazd*deltazd;
+        delta3 = delta2*deltazd;
+        delta4 = delta3*deltazd;
+        coeffzd[0][i] = dble_1_ov_384   - dble_1_ov_48  * deltazd  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        coeffzd[1][i] = dble_19_ov_96   - dble_11_ov_24 * deltazd  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffzd[2][i] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+        coeffzd[3][i] = dble_19_ov_96   + dble_11_ov_24 * deltazd  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffzd[4][i] = dble_1_ov_384   + dble_1_ov_48  * deltazd  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        double deltazp = zpn - (double)kp_i;
+        delta2 = deltazp*deltazp;
+        delta3 = delta2*deltazp;
+        delta4 = delta3*deltazp;
+        coeffzp[0][i] = dble_1_ov_384   - dble_1_ov_48  * deltazp  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        coeffzp[1][i] = dble_19_ov_96   - dble_11_ov_24 * deltazp  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffzp[2][i] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+        coeffzp[3][i] = dble_19_ov_96   + dble_11_ov_24 * deltazp  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+        coeffzp[4][i] = dble_1_ov_384   + dble_1_ov_48  * deltazp  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+        kp[i] = kp_i - k_domain_begin;
+        kd[i] = kd_i - k_domain_begin;
+
+        // Buffering of iold and delta
+        iold[i+0*nparts]  = ip[i];
+        iold[i+1*nparts]  = jp[i];
+        iold[i+2*nparts]  = kp[i];
+        delta[i+0*nparts] = deltaxp;
+        delta[i+1*nparts] = deltayp;
+        delta[i+2*nparts] = deltazp;
+    }
+
+    // Interpolation of Ex^(d,p,p)
+    compute_block( coeffxd, coeffyp, coeffzp, Ex3D, id, jp, kp, np, Epart+0*nparts );
+    // Interpolation of Ey^(p,d,p)
+    compute_block( coeffxp, coeffyd, coeffzp, Ey3D, ip, jd, kp, np, Epart+1*nparts );
+    // Interpolation of Ez^(p,p,d)
+    compute_block( coeffxp, coeffyp, coeffzd, Ez3D, ip, jp, kd, np, Epart+2*nparts );
+    // Interpolation of Bx^(p,d,d)
+    compute_block( coeffxp, coeffyd, coeffzd, Bx3D, ip, jd, kd, np, Bpart+0*nparts );
+    // Interpolation of By^(d,p,d)
+    compute_block( coeffxd, coeffyp, coeffzd, By3D, id, jp, kd, np, Bpart+1*nparts );
+    // Interpolation of Bz^(d,d,p)
+    compute_block( coeffxd, coeffyd, coeffzp, Bz3D, id, jd, kp, np, Bpart+2*nparts );
 
+} // END interpolate_block
@@ -37,6 +37,9 @@ protected:
     unsigned int nDim_field;
     unsigned int nDim_particle;
     double ionized_species_invmass;
+    
+    //! Uniform random numbers of the particles of the bin, drawn at once
+    std::vector<double> ran_p_;
 
 private:
 
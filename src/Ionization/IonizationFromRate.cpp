@@ -55,6 +55,9 @@ void IonizationFromRate::operator() (Particles* particles, unsigned int ipart_mi
     }
 #endif
 
+    // One random number per particle, so that the draws do not depend on the charge states
+    ran_p_.resize( ipart_max-ipart_min );
+    Rand::uniform( ran_p_.data(), ipart_max-ipart_min );
     
     for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
         
@@ -67,7 +70,7 @@ void IonizationFromRate::operator() (Particles* particles, unsigned int ipart_mi
         // Start of the Monte-Carlo routine  (At the moment, only 1 ionization per timestep is possible)
         // k_times will give the nb of ionization events
         k_times = 0;
-        double ran_p = Rand::uniform();
+        double ran_p = ran_p_[ipart-ipart_min];
         if ( ran_p < 1.0 - exp(-rate[ipart-ipart_min]*dt) ) {
             k_times        = 1;
         }
@@ -60,6 +60,10 @@ void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min,
     double* Ey = &( (*Epart)[1*nparts] );
     double* Ez = &( (*Epart)[2*nparts] );
     
+    // One random number per particle, so that the draws do not depend on the charge states
+    ran_p_.resize( ipart_max-ipart_min );
+    Rand::uniform( ran_p_.data(), ipart_max-ipart_min );
+    
     for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
         
         // Current charge state of the ion
@@ -81,7 +85,7 @@ void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min,
         invE = 1./E;
         factorJion = factorJion_0 * invE*invE;
         delta      = gamma_tunnel[Z]*invE;
-        ran_p = Rand::uniform();
+        ran_p = ran_p_[ipart-ipart_min];
         IonizRate_tunnel[Z] = beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log(delta));
         
         // Total ionization potential (used to compute the ionization current)
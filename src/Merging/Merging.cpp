@@ -0,0 +1,38 @@
+// ----------------------------------------------------------------------------
+//! \file Merging.cpp
+//
+//! \brief This file contains the class functions for the generic class
+//!  Merging for the reduction of the number of macro-particles.
+//
+// ----------------------------------------------------------------------------
+
+#include "Merging.h"
+
+// -----------------------------------------------------------------------------
+//! Constructor for Merging
+// input: simulation parameters & Species index
+//! \param params simulation parameters
+//! \param species Species index
+// -----------------------------------------------------------------------------
+Merging::Merging(Params& params, Species * species)
+{
+    // Dimension position
+    nDim_ = params.nDim_particle;
+
+    mass_ = species->mass;
+
+    for (unsigned int i=0 ; i<3 ; i++)
+        dx_inv_[i] = (i<params.cell_length.size() && params.cell_length[i]>0.) ? 1./params.cell_length[i] : 0.;
+
+    min_particles_per_cell_ = species->merge_min_particles_per_cell;
+    packet_size_            = species->merge_packet_size;
+    for (unsigned int i=0 ; i<3 ; i++)
+        momentum_cells_[i] = species->merge_momentum_cell_size[i];
+}
+
+// -----------------------------------------------------------------------------
+//! Destructor for Merging
+// -----------------------------------------------------------------------------
+Merging::~Merging()
+{
+}
@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+//! \file Merging.h
+//
+//! \brief This file contains the header for the generic class Merging
+//   for the reduction of the number of macro-particles.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef MERGING_H
+#define MERGING_H
+
+#include <vector>
+
+#include "Params.h"
+#include "Particles.h"
+#include "Species.h"
+
+//  ----------------------------------------------------------------------------
+//! Class Merging
+//  ----------------------------------------------------------------------------
+class Merging
+{
+
+    public:
+        //! Creator for Merging
+        Merging(Params& params, Species *species);
+        virtual ~Merging();
+
+        //! Overloading of () operator : merge the particles of a bin
+        //! Particles removed by the merging are given a null weight,
+        //! they are erased afterwards by Particles::erase_null_weight
+        //! \param particles   particle object containing the particle
+        //!                    properties of the current species
+        //! \param istart      Index of the first particle
+        //! \param iend        Index of the last particle
+        //! \return number of macro-particles removed
+        virtual unsigned int operator() (
+                Particles &particles,
+                int istart,
+                int iend) = 0;
+
+    protected:
+
+        //! Dimension of position
+        int nDim_;
+
+        //! Mass of the species (photons if 0)
+        double mass_;
+
+        //! Inverse of the cell length
+        double dx_inv_[3];
+
+        //! Cells with less macro-particles than this are not merged
+        unsigned int min_particles_per_cell_;
+
+        //! Number of macro-particles merged at once
+        unsigned int packet_size_;
+
+        //! Number of momentum cells in each direction (px, py, pz)
+        unsigned int momentum_cells_[3];
+
+};//END class
+
+#endif
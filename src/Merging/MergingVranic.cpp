@@ -0,0 +1,224 @@
+// ----------------------------------------------------------------------------
+//! \file MergingVranic.cpp
+//
+//! \brief This file contains the class functions for the macro-particle
+//!        merging method of M. Vranic et al.
+//
+//! M. Vranic et al., CPC 191, 65-73 (2015)
+// ----------------------------------------------------------------------------
+
+#include "MergingVranic.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+//! Constructor for MergingVranic
+//! \param params simulation parameters
+//! \param species Species index
+// -----------------------------------------------------------------------------
+MergingVranic::MergingVranic(Params& params, Species * species)
+      : Merging(params, species)
+{
+}
+
+// -----------------------------------------------------------------------------
+//! Destructor for MergingVranic
+// -----------------------------------------------------------------------------
+MergingVranic::~MergingVranic()
+{
+}
+
+// -----------------------------------------------------------------------------
+//! Overloading of () operator: merge the macro-particles of a bin.
+//! The particles are first sorted by cell, only the cells containing at least
+//! min_particles_per_cell_ macro-particles are merged.
+//! \param particles   particle object containing the particle
+//!                    properties
+//! \param istart      Index of the first particle
+//! \param iend        Index of the last particle
+// -----------------------------------------------------------------------------
+unsigned int MergingVranic::operator() (
+        Particles &particles,
+        int istart,
+        int iend)
+{
+    unsigned int npart = iend - istart;
+    if (npart < min_particles_per_cell_)
+        return 0;
+
+    // Cell indices of the particles, relative to the smallest one of the bin
+    int cmin[3] = {0, 0, 0};
+    int64_t ncell[3] = {1, 1, 1};
+    for (int idim=0 ; idim<nDim_ ; idim++) {
+        int cmax;
+        cmin[idim] = cmax = (int)floor( particles.position(idim, istart) * dx_inv_[idim] );
+        for (int ipart=istart+1 ; ipart<iend ; ipart++) {
+            int c = (int)floor( particles.position(idim, ipart) * dx_inv_[idim] );
+            cmin[idim] = std::min(cmin[idim], c);
+            cmax       = std::max(cmax, c);
+        }
+        ncell[idim] = cmax - cmin[idim] + 1;
+    }
+
+    cell_key_.resize(npart);
+    for (int ipart=istart ; ipart<iend ; ipart++) {
+        int64_t key = 0;
+        for (int idim=0 ; idim<nDim_ ; idim++)
+            key = key * ncell[idim] + ( (int)floor( particles.position(idim, ipart) * dx_inv_[idim] ) - cmin[idim] );
+        cell_key_[ipart-istart] = std::make_pair(key, (unsigned int)ipart);
+    }
+    std::sort( cell_key_.begin(), cell_key_.end() );
+
+    // Merge the cells with enough macro-particles
+    unsigned int nremoved = 0;
+    unsigned int ibegin = 0;
+    while (ibegin < npart) {
+        unsigned int iend_cell = ibegin+1;
+        while ( (iend_cell < npart) && (cell_key_[iend_cell].first == cell_key_[ibegin].first) )
+            iend_cell++;
+        if (iend_cell - ibegin >= min_particles_per_cell_)
+            nremoved += merge_cell( particles, ibegin, iend_cell );
+        ibegin = iend_cell;
+    }
+
+    return nremoved;
+}
+
+// -----------------------------------------------------------------------------
+//! Merge the macro-particles of a cell: the momentum space spanned by the
+//! particles of the cell is divided in momentum_cells_ cells, the particles of
+//! a momentum cell with the same charge are merged by packets of packet_size_.
+// -----------------------------------------------------------------------------
+unsigned int MergingVranic::merge_cell( Particles &particles, unsigned int ibegin, unsigned int iend )
+{
+    // Momentum space spanned by the particles of the cell
+    double pmin[3], inv_dp[3];
+    for (unsigned int i=0 ; i<3 ; i++) {
+        double pmax;
+        pmin[i] = pmax = particles.momentum(i, cell_key_[ibegin].second);
+        for (unsigned int j=ibegin+1 ; j<iend ; j++) {
+            double p = particles.momentum(i, cell_key_[j].second);
+            pmin[i] = std::min(pmin[i], p);
+            pmax    = std::max(pmax, p);
+        }
+        inv_dp[i] = (pmax > pmin[i]) ? momentum_cells_[i] / (pmax - pmin[i]) : 0.;
+    }
+
+    // Momentum cell and charge of each particle
+    momentum_key_.resize(iend-ibegin);
+    for (unsigned int j=ibegin ; j<iend ; j++) {
+        unsigned int ipart = cell_key_[j].second;
+        int64_t key = 0;
+        for (unsigned int i=0 ; i<3 ; i++) {
+            int64_t ip = std::min( (int64_t)( (particles.momentum(i, ipart) - pmin[i]) * inv_dp[i] ),
+                                   (int64_t)momentum_cells_[i]-1 );
+            key = key * momentum_cells_[i] + ip;
+        }
+        key = ( key << 16 ) + ( (int64_t)particles.charge(ipart) + 32768 );
+        momentum_key_[j-ibegin] = std::make_pair(key, ipart);
+    }
+    std::sort( momentum_key_.begin(), momentum_key_.end() );
+
+    // Merge the momentum cells by packets
+    unsigned int nremoved = 0;
+    unsigned int n = iend-ibegin;
+    unsigned int jbegin = 0;
+    while (jbegin < n) {
+        unsigned int jend = jbegin+1;
+        while ( (jend < n) && (momentum_key_[jend].first == momentum_key_[jbegin].first) )
+            jend++;
+        for (unsigned int j=jbegin ; j<jend ; j+=packet_size_) {
+            unsigned int jpacket_end = std::min(j+packet_size_, jend);
+            // Merging less than 3 macro-particles into 2 is useless
+            if (jpacket_end - j >= 3)
+                nremoved += merge_packet( particles, j, jpacket_end );
+        }
+        jbegin = jend;
+    }
+
+    return nremoved;
+}
+
+// -----------------------------------------------------------------------------
+//! Merge a packet of macro-particles into two macro-particles a and b of
+//! same weight w_t/2 and same energy, and momenta symmetric with respect
+//! to the total momentum p_t of the packet:
+//!     p_a,b = |p_a| ( cos(w) e1 +/- sin(w) e2 ), e1 = p_t/|p_t|,
+//!     cos(w) = |p_t| / ( w_t |p_a| )
+//! where e2 is perpendicular to e1, in the plane of e1 and the momentum of
+//! the first particle of the packet.
+// -----------------------------------------------------------------------------
+unsigned int MergingVranic::merge_packet( Particles &particles, unsigned int ibegin, unsigned int iend )
+{
+    double w_t = 0.;
+    double e_t = 0.;
+    double p_t[3] = {0., 0., 0.};
+
+    for (unsigned int j=ibegin ; j<iend ; j++) {
+        unsigned int ipart = momentum_key_[j].second;
+        double w  = particles.weight(ipart);
+        double px = particles.momentum(0, ipart);
+        double py = particles.momentum(1, ipart);
+        double pz = particles.momentum(2, ipart);
+        double p2 = px*px + py*py + pz*pz;
+        w_t    += w;
+        p_t[0] += w * px;
+        p_t[1] += w * py;
+        p_t[2] += w * pz;
+        // Energy normalized by m c^2 for particles, by m_e c^2 for photons
+        e_t    += w * ( (mass_ > 0) ? sqrt(1. + p2) : sqrt(p2) );
+    }
+
+    double p_t_norm = sqrt( p_t[0]*p_t[0] + p_t[1]*p_t[1] + p_t[2]*p_t[2] );
+    if ( (w_t <= 0.) || (p_t_norm <= 0.) )
+        return 0;
+
+    // Norm of the momentum of the two new particles
+    double gamma_a = e_t / w_t;
+    double p_a = (mass_ > 0) ? sqrt( std::max(gamma_a*gamma_a - 1., 0.) ) : gamma_a;
+    if (p_a <= 0.)
+        return 0;
+
+    double cos_omega = std::min( p_t_norm / ( w_t * p_a ), 1. );
+    double sin_omega = sqrt( 1. - cos_omega*cos_omega );
+
+    double e1[3], e2[3];
+    for (unsigned int i=0 ; i<3 ; i++)
+        e1[i] = p_t[i] / p_t_norm;
+
+    // e2 : component of the momentum of the first particle perpendicular to e1,
+    // or of the axis the least aligned with e1 if this momentum is along e1
+    unsigned int ifirst = momentum_key_[ibegin].second;
+    for (unsigned int i=0 ; i<3 ; i++)
+        e2[i] = particles.momentum(i, ifirst);
+    double e1e2 = e1[0]*e2[0] + e1[1]*e2[1] + e1[2]*e2[2];
+    for (unsigned int i=0 ; i<3 ; i++)
+        e2[i] -= e1e2 * e1[i];
+    double e2_norm = sqrt( e2[0]*e2[0] + e2[1]*e2[1] + e2[2]*e2[2] );
+    if ( e2_norm <= 1.e-10 * p_a ) {
+        unsigned int iaxis = 0;
+        for (unsigned int i=1 ; i<3 ; i++)
+            if ( std::abs(e1[i]) < std::abs(e1[iaxis]) ) iaxis = i;
+        for (unsigned int i=0 ; i<3 ; i++)
+            e2[i] = ( (i==iaxis) ? 1. : 0. ) - e1[iaxis] * e1[i];
+        e2_norm = sqrt( e2[0]*e2[0] + e2[1]*e2[1] + e2[2]*e2[2] );
+    }
+    for (unsigned int i=0 ; i<3 ; i++)
+        e2[i] /= e2_norm;
+
+    // The first two particles of the packet become the new particles a and b
+    unsigned int ia = momentum_key_[ibegin  ].second;
+    unsigned int ib = momentum_key_[ibegin+1].second;
+    for (unsigned int i=0 ; i<3 ; i++) {
+        particles.momentum(i, ia) = p_a * ( cos_omega * e1[i] + sin_omega * e2[i] );
+        particles.momentum(i, ib) = p_a * ( cos_omega * e1[i] - sin_omega * e2[i] );
+    }
+    particles.weight(ia) = 0.5 * w_t;
+    particles.weight(ib) = 0.5 * w_t;
+
+    // The other particles are removed afterwards by Particles::erase_null_weight
+    for (unsigned int j=ibegin+2 ; j<iend ; j++)
+        particles.weight( momentum_key_[j].second ) = 0.;
+
+    return iend - ibegin - 2;
+}
@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------------
+//! \file MergingVranic.h
+//
+//! \brief This class is for the macro-particle merging method of
+//!        M. Vranic et al.
+//
+//! \details This header contains the definition of the class MergingVranic.
+//! M. Vranic et al., CPC 191, 65-73 (2015)
+// ----------------------------------------------------------------------------
+
+#ifndef MERGINGVRANIC_H
+#define MERGINGVRANIC_H
+
+#include "Merging.h"
+
+#include <vector>
+#include <utility>
+#include <cmath>
+
+//------------------------------------------------------------------------------
+//! MergingVranic class: in each cell containing enough macro-particles,
+//! the macro-particles are sorted in momentum cells and the macro-particles
+//! of a momentum cell are merged by packets into 2 macro-particles conserving
+//! the weight (charge), the momentum and the energy of the packet.
+//------------------------------------------------------------------------------
+class MergingVranic : public Merging {
+
+    public:
+
+        //! Constructor for MergingVranic
+        MergingVranic(Params& params, Species * species);
+
+        //! Destructor for MergingVranic
+        ~MergingVranic();
+
+        // ---------------------------------------------------------------------
+        //! Overloading of () operator: merge the macro-particles of a bin
+        //! \param particles   particle object containing the particle
+        //!                    properties
+        //! \param istart      Index of the first particle
+        //! \param iend        Index of the last particle
+        //! \return number of macro-particles removed
+        // ---------------------------------------------------------------------
+        virtual unsigned int operator() (
+                Particles &particles,
+                int istart,
+                int iend);
+
+    private:
+
+        //! Merge the macro-particles of a cell, entries [ibegin, iend[ of cell_key_
+        unsigned int merge_cell( Particles &particles, unsigned int ibegin, unsigned int iend );
+
+        //! Merge a packet of macro-particles (same momentum cell, same charge),
+        //! entries [ibegin, iend[ of momentum_key_, into the first two ones.
+        //! The others are given a null weight.
+        unsigned int merge_packet( Particles &particles, unsigned int ibegin, unsigned int iend );
+
+        //! (cell, particle index) of the particles of the bin, sorted by cell
+        std::vector<std::pair<int64_t,unsigned int> > cell_key_;
+
+        //! (momentum cell and charge, particle index) of the particles of a cell
+        std::vector<std::pair<int64_t,unsigned int> > momentum_key_;
+
+};
+
+#endif
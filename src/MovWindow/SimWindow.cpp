@@ -154,6 +154,8 @@ void SimWindow::operate(VectorPatch& vecPatches, SmileiMPI* smpi, Params& params
                 mypatch->tmp_MPI_neighbor_[idim][0] = vecPatches_old[mypatch->hindex - h0 ]->MPI_neighbor_[idim][0];
                 mypatch->tmp_MPI_neighbor_[idim][1] = vecPatches_old[mypatch->hindex - h0 ]->MPI_neighbor_[idim][1];
             }
+            mypatch->tmp_direct_neighbor_     = vecPatches_old[mypatch->hindex - h0 ]->direct_neighbor_;
+            mypatch->tmp_direct_MPI_neighbor_ = vecPatches_old[mypatch->hindex - h0 ]->direct_MPI_neighbor_;
             update_patches_.push_back(mypatch); // Stores pointers to patches that will need to update some neighbors from tmp_neighbors.
 
             //And finally put the patch at the correct rank in vecPatches.
@@ -215,6 +217,8 @@ void SimWindow::operate(VectorPatch& vecPatches, SmileiMPI* smpi, Params& params
             mypatch->neighbor_[idim][0] = mypatch->tmp_neighbor_[idim][0];
             mypatch->neighbor_[idim][1] = mypatch->tmp_neighbor_[idim][1];
         }
+        mypatch->direct_neighbor_     = mypatch->tmp_direct_neighbor_;
+        mypatch->direct_MPI_neighbor_ = mypatch->tmp_direct_MPI_neighbor_;
 
         mypatch->updateTagenv(smpi);
         if ( mypatch->isXmin() ){
@@ -385,59 +385,5 @@ void MultiphotonBreitWheeler::decayed_photon_cleaning(
                 int ibin, int nbin,
                 int * bmin,int * bmax)
 {
-    if (bmax[ibin] > bmin[ibin])
-    {
-        // Weight shortcut
-        double* weight = &( particles.weight(0) );
-
-        // Index of the last existing photon (weight > 0)
-        int last_photon_index;
-        int first_photon_index;
-        int ii;
-        int nb_deleted_photon;
-
-        // Backward loop over the photons to fing the first existing photon
-        last_photon_index = bmax[ibin]-1;
-        first_photon_index = bmin[ibin];
-        while ((last_photon_index >= bmin[ibin])
-           && (weight[last_photon_index] <= 0))
-        {
-                last_photon_index--;
-        }
-        while ((first_photon_index < bmax[ibin])
-           && (weight[first_photon_index] > 0))
-        {
-                first_photon_index++;
-        }
-        // At this level, last_photon_index is the position of the last photon
-        // that will not be erased
-
-        // Backward loop over the photons to fill holes in the photon particle array
-        for (int ipart=last_photon_index-1 ; ipart>=bmin[ibin]; ipart-- )
-        {
-            if (weight[ipart] <= 0)
-            {
-                if (ipart < last_photon_index)
-                {
-                    // The last existing photon comes to the position of
-                    // the deleted photon
-                    particles.overwrite_part(last_photon_index,ipart);
-                    last_photon_index --;
-                }
-            }
-        }
-
-        // Removal of the photons
-        nb_deleted_photon = bmax[ibin]-last_photon_index-1;
-
-        if (nb_deleted_photon > 0)
-        {
-            particles.erase_particle(last_photon_index+1,nb_deleted_photon);
-            bmax[ibin] = last_photon_index+1;
-            for (ii=ibin+1; ii<nbin; ii++) {
-                bmin[ii] -= nb_deleted_photon;
-                bmax[ii] -= nb_deleted_photon;
-            }
-        }
-    }
+    particles.erase_null_weight(ibin, nbin, bmin, bmax);
 }
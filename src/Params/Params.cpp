@@ -22,26 +22,8 @@ using namespace std;
 namespace Rand
 {
     std::random_device device;
-    std::mt19937 gen(device());
-
-    std::uniform_real_distribution<double> uniform_distribution(0., 1.);
-    double uniform() {
-        return uniform_distribution(gen);
-    }
-
-    std::uniform_real_distribution<double> uniform_distribution1(0., 1.-1e-11);
-    double uniform1() {
-        return uniform_distribution1(gen);
-    }
-
-    std::uniform_real_distribution<double> uniform_distribution2(-1., 1.);
-    double uniform2() {
-        return uniform_distribution2(gen);
-    }
-    double normal(double stddev) {
-        std::normal_distribution<double> normal_distribution(0., stddev);
-        return normal_distribution(gen);
-    }
+    uint32_t seed = device();
+    thread_local Random stream( seed );
 }
 
 #define DO_EXPAND(VAL)  VAL ## 1
@@ -185,11 +167,13 @@ namelist("")
     // random seed
     unsigned int random_seed=0;
     if (PyTools::extract("random_seed", random_seed, "Main")) {
-        // Init of the seed for the vectorized C++ random generator recommended by Intel
-        // See https://software.intel.com/en-us/articles/random-number-function-vectorization
-        srand48(random_seed);
-        // Init of the seed for the C++ random generator
-        Rand::gen = std::mt19937(random_seed);
+        // Init of the seed of the counter-based random streams
+        Rand::seed = random_seed;
+    } else {
+        // Streams are keyed by patch, all processes must share the same seed
+        int seed = Rand::seed;
+        smpi->bcast( seed );
+        Rand::seed = seed;
     }
 
     // communication pattern initialized as partial B exchange
@@ -239,6 +223,25 @@ namelist("")
     exchange_particles_each = 1;
 
     PyTools::extract("every_clean_particles_overhead", every_clean_particles_overhead, "Main");
+    PyTools::extract("particles_capacity_watermarks", particles_capacity_watermarks, "Main");
+    if ( particles_capacity_watermarks.size() != 2 || particles_capacity_watermarks[1] < 1.
+      || particles_capacity_watermarks[0] < particles_capacity_watermarks[1] )
+        ERROR("particles_capacity_watermarks must be a list [high, low] with high >= low >= 1");
+    PyTools::extract("particles_capacity_decay", particles_capacity_decay, "Main");
+    if ( particles_capacity_decay < 0. || particles_capacity_decay > 1. )
+        ERROR("particles_capacity_decay must be between 0 and 1");
+
+    PyTools::extract("direct_particle_exchange", direct_particle_exchange, "Main");
+    PyTools::extract("aggregate_ghost_messages", aggregate_ghost_messages, "Main");
+    PyTools::extract("shared_memory_exchanges", shared_memory_exchanges, "Main");
+    if ( shared_memory_exchanges && !aggregate_ghost_messages )
+        ERROR("shared_memory_exchanges requires aggregate_ghost_messages");
+    PyTools::extract("field_arena", field_arena, "Main");
+    PyTools::extract("field_arena_huge_pages", field_arena_huge_pages, "Main");
+    if ( field_arena_huge_pages && !field_arena )
+        ERROR("field_arena_huge_pages requires field_arena");
+    if ( shared_memory_exchanges && !field_arena )
+        ERROR("shared_memory_exchanges requires field_arena");
 
     // TIME & SPACE RESOLUTION/TIME-STEPS
 
@@ -350,9 +353,13 @@ namelist("")
     PyTools::extract("maxwell_solver", maxwell_sol, "Main");
     if (maxwell_sol == "Lehe")
         full_B_exchange=true;
+    PyTools::extract("fused_field_step", fused_field_step, "Main");
+    if ( fused_field_step && ( (geometry!="3Dcartesian") || (maxwell_sol!="Yee") || is_pxr || is_spectral ) )
+        ERROR("fused_field_step is only available in 3Dcartesian geometry with the Yee solver");
 
     // Current filter properties
     currentFilter_passes = 0;
+    currentFilter_single_exchange = false;
     int nCurrentFilter = PyTools::nComponents("CurrentFilter");
     for (int ifilt = 0; ifilt < nCurrentFilter; ifilt++) {
         string model;
@@ -360,6 +367,7 @@ namelist("")
         if( model != "binomial" )
             ERROR("Currently, only the `binomial` model is available in CurrentFilter()");
         PyTools::extract("passes", currentFilter_passes, "CurrentFilter", ifilt);
+        PyTools::extract("single_exchange", currentFilter_single_exchange, "CurrentFilter", ifilt);
     }
 
     // Field filter properties
@@ -462,8 +470,10 @@ namelist("")
         PyTools::extract("cell_load"  , cell_load      , "LoadBalancing");
         PyTools::extract("frozen_particle_load", frozen_particle_load    , "LoadBalancing");
         PyTools::extract("initial_balance", initial_balance    , "LoadBalancing");
+        PyTools::extract("measured_cost", measured_cost    , "LoadBalancing");
     } else {
         load_balancing_time_selection = new TimeSelection();
+        measured_cost = false;
     }
 
     has_load_balancing = (smpi->getSize()>1)  && (! load_balancing_time_selection->isEmpty());
@@ -705,6 +715,9 @@ void Params::compute()
     
     for (unsigned int i=0; i<nDim_field; i++){
         oversize[i]  = max(interpolation_order,(unsigned int)(norder[i]/2+1)) + (exchange_particles_each-1);;
+        // The ghost cells must stay valid through all the passes of the current filter
+        if ( currentFilter_single_exchange )
+            oversize[i] = max(oversize[i], currentFilter_passes);
         n_space_global[i] = n_space[i];
         n_space[i] /= number_of_patches[i];
         if(n_space_global[i]%number_of_patches[i] !=0) ERROR("ERROR in dimension " << i <<". Number of patches = " << number_of_patches[i] << " must divide n_space_global = " << n_space_global[i]);
@@ -815,6 +828,8 @@ void Params::print_init()
         MESSAGE(1,"Happens: " << load_balancing_time_selection->info());
         MESSAGE(1,"Cell load coefficient = " << cell_load );
         MESSAGE(1,"Frozen particle load coefficient = " << frozen_particle_load );
+        if (measured_cost)
+            MESSAGE(1,"Load of patches measured from their wall-clock time (measured_cost = true)");
     }
 }
 
@@ -14,6 +14,7 @@
 #include "Profile.h"
 #include "Timer.h"
 #include "codeConstants.h"
+#include "Random.h"
 
 #include <vector>
 #include <string>
@@ -34,19 +35,46 @@ class Species;
 namespace Rand
 {
     extern std::random_device device;
-    extern std::mt19937 gen;
 
-    extern std::uniform_real_distribution<double> uniform_distribution;
-    extern double uniform();
+    //! Seed of all the random streams (Main.random_seed, or drawn from device)
+    extern uint32_t seed;
 
-    extern std::uniform_real_distribution<double> uniform_distribution1;
-    extern double uniform1();
+    //! Random stream owned by the current thread
+    extern thread_local Random stream;
 
-    extern std::uniform_real_distribution<double> uniform_distribution2;
-    extern double uniform2();
+    //! Identifiers of the streams, combined with the patch and the timestep
+    //! Particle dynamics use the species number as stream id
+    const uint32_t collisions_stream     = 0x10000;
+    const uint32_t particle_init_stream  = 0x20000;
 
-    extern std::normal_distribution<double> normal_distribution;
-    extern double normal(double stddev);
+    //! Select the stream (patch, stream_id, timestep) of the current thread
+    inline void setStream( unsigned int patch, unsigned int stream_id, unsigned int timestep ) {
+        stream.setStream( seed, patch, stream_id, timestep );
+    }
+
+    inline double uniform() {
+        return stream.uniform();
+    }
+    inline double uniform1() {
+        return stream.uniform1();
+    }
+    inline double uniform2() {
+        return stream.uniform2();
+    }
+    inline double normal(double stddev) {
+        return stream.normal( stddev );
+    }
+
+    //! Batch versions, fill a buffer of n values
+    inline void uniform( double * out, unsigned int n ) {
+        stream.uniform( out, n );
+    }
+    inline void uniform2( double * out, unsigned int n ) {
+        stream.uniform2( out, n );
+    }
+    inline void normal( double * out, unsigned int n, double stddev ) {
+        stream.normal( out, n, stddev );
+    }
 }
 
 
@@ -142,10 +170,16 @@ public:
 
     //! Maxwell Solver (default='Yee')
     std::string maxwell_sol;
+
+    //! Save B, solve Maxwell-Ampere and Maxwell-Faraday in a single sweep of the patches (default=false)
+    bool fused_field_step;
     
     //! Current spatial filter: number of binomial passes
     unsigned int currentFilter_passes;
     
+    //! Current spatial filter: all the passes between two exchanges of the ghost cells, widened to the number of passes
+    bool currentFilter_single_exchange;
+    
     //! is Friedman filter applied [Greenwood et al., J. Comp. Phys. 201, 665 (2004)]
     bool Friedman_filter;
 
@@ -197,8 +231,26 @@ public:
     //! frequency of exchange particles (default = 1, disabled for now, incompatible with sort)
     int exchange_particles_each;
     
-    //! frequency to apply shrink_to_fit on particles structure
+    //! frequency to apply the capacity policy on particles structure
     int every_clean_particles_overhead;
+    //! Capacity of particles structure released above particles_capacity_watermarks[0] * peak size,
+    //! down to particles_capacity_watermarks[1] * peak size
+    std::vector<double> particles_capacity_watermarks;
+    //! Decay of the peak size of particles structure from one capacity check to the next
+    double particles_capacity_decay;
+
+    //! Particles exchanged in a single round with the face, edge and corner neighbors, instead of one round per direction
+    bool direct_particle_exchange;
+
+    //! Ghost cells of the fields sent in a single message per neighbor MPI process, instead of one per patch, field and direction
+    bool aggregate_ghost_messages;
+
+    //! Field arenas in shared memory, from which the MPI processes of the same node read the ghost cells directly
+    bool shared_memory_exchanges;
+
+    //! Fields of each patch carved from a single allocation (FieldArena), optionally on huge pages
+    bool field_arena;
+    bool field_arena_huge_pages;
 
     //! Total number of patches
     unsigned int tot_number_of_patches;
@@ -221,6 +273,8 @@ public:
     bool one_patch_per_MPI;
     //! Compute an initially balanced patch distribution right from the start
     bool initial_balance;
+    //! Balance on the measured wall-clock time of patches instead of the cell/particle load model
+    bool measured_cost;
 
     bool vecto;
 
@@ -33,6 +33,7 @@
 #include "ProjectorFactory.h"
 #include "DiagnosticFactory.h"
 #include "CollisionsFactory.h"
+#include "DomainDecomposition.h"
 
 using namespace std;
 
@@ -86,6 +87,10 @@ void Patch::initStep1(Params& params)
     oversize.resize( nDim_fields_ );
     for ( int iDim = 0 ; iDim < nDim_fields_; iDim++ )
         oversize[iDim] = params.oversize[iDim];
+
+    MPIenv_version_ = 0;
+
+    cost = 0.;
 }
 
 
@@ -318,11 +323,49 @@ Patch::~Patch() {
 } // END Patch::~Patch
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Compute Hilbert index of the face, edge and corner neighbors, used by the direct exchange of particles
+//   - called by PatchXD::initStep2 once Pcoordinates is defined
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::setDirectNeighbors(Params& params, DomainDecomposition* domain_decomposition)
+{
+    int ndir = 1;
+    for (int iDim = 0 ; iDim < nDim_fields_ ; iDim++)
+        ndir *= 3;
+    direct_neighbor_    .resize(ndir, MPI_PROC_NULL);
+    direct_MPI_neighbor_.resize(ndir, MPI_PROC_NULL);
+    tmp_direct_neighbor_    .resize(ndir, MPI_PROC_NULL);
+    tmp_direct_MPI_neighbor_.resize(ndir, MPI_PROC_NULL);
+
+    std::vector<int> xcall( nDim_fields_, 0 );
+    for (int idir = 0 ; idir < ndir ; idir++) {
+        bool exists = ( idir != (ndir-1)/2 ); // The patch itself
+        int jdir = idir;
+        for (int iDim = 0 ; iDim < nDim_fields_ ; iDim++) {
+            int ndomain = domain_decomposition->ndomain_[iDim];
+            xcall[iDim] = Pcoordinates[iDim] + jdir%3 - 1;
+            jdir /= 3;
+            if (params.EM_BCs[iDim][0]=="periodic") {
+                if (xcall[iDim] < 0)
+                    xcall[iDim] += ndomain;
+                else if (xcall[iDim] >= ndomain)
+                    xcall[iDim] -= ndomain;
+            }
+            else if ( (xcall[iDim] < 0) || (xcall[iDim] >= ndomain) )
+                exists = false;
+        }
+        direct_neighbor_[idir] = exists ? domain_decomposition->getDomainId( xcall ) : MPI_PROC_NULL;
+    }
+
+} // END setDirectNeighbors
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Compute MPI rank of patch neigbors and current patch
 // ---------------------------------------------------------------------------------------------------------------------
 void Patch::updateTagenv(SmileiMPI* smpi)
 {
+    MPIenv_version_++;
 }
 void Patch::updateMPIenv(SmileiMPI* smpi)
 {
@@ -353,37 +396,78 @@ void Patch::updateMPIenv(SmileiMPI* smpi)
 //            }
         }
 
+    for (unsigned int idir = 0 ; idir < direct_neighbor_.size() ; idir++)
+        direct_MPI_neighbor_[idir] = smpi->hrank(direct_neighbor_[idir]);
+
+    updateTagenv(smpi);
+
 } // END updateMPIenv
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Split particles Id to send in per direction and per patch neighbor dedicated buffers
-// Apply periodicity if necessary
+// Reset the exchange buffers of species ispec
+// Done for all patches before the dynamics, as the neighbors set part_index_recv_sz during their dynamics
 // ---------------------------------------------------------------------------------------------------------------------
-void Patch::initExchParticles(SmileiMPI* smpi, int ispec, Params& params)
+void Patch::clearExchParticles(int ispec, Params& params)
 {
-    Particles &cuParticles = (*vecSpecies[ispec]->particles);
     int ndim = params.nDim_field;
-    int idim,check;
-    std::vector<int>* indexes_of_particles_to_exchange = &vecSpecies[ispec]->indexes_of_particles_to_exchange;
-//    double xmax[3];
 
     for (int iDim=0 ; iDim < ndim ; iDim++){
         for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
             vecSpecies[ispec]->MPIbuff.partRecv[iDim][iNeighbor].clear();//resize(0,ndim);
-            vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor].clear();//resize(0,ndim);
+            vecSpecies[ispec]->MPIbuff.partRecvBuffer[iDim][iNeighbor].clear();
             vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].resize(0);
             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
         }
     }
+    for (unsigned int idir = 0 ; idir < direct_neighbor_.size() ; idir++) {
+        vecSpecies[ispec]->MPIbuff.direct_partRecv[idir].clear();
+        vecSpecies[ispec]->MPIbuff.direct_partRecvBuffer[idir].clear();
+        vecSpecies[ispec]->MPIbuff.direct_part_index_send[idir].resize(0);
+        vecSpecies[ispec]->MPIbuff.direct_part_index_recv_sz[idir] = 0;
+    }
+
+} // clearExchParticles
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Split particles Id to send in per direction and per patch neighbor dedicated buffers
+// Only the particles to exchange from the ipart_start-th one are treated
+// Apply periodicity if necessary
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::initExchParticles(SmileiMPI* smpi, int ispec, Params& params, unsigned int ipart_start)
+{
+    Particles &cuParticles = (*vecSpecies[ispec]->particles);
+    int ndim = params.nDim_field;
+    int idim,check;
+    std::vector<int>* indexes_of_particles_to_exchange = &vecSpecies[ispec]->indexes_of_particles_to_exchange;
+//    double xmax[3];
 
     int n_part_send = (*indexes_of_particles_to_exchange).size();
 
     int iPart;
 
+    // Direct exchange : put particles in the send buffer of the face, edge or corner neighbor they go to
+    if (params.direct_particle_exchange) {
+        for (int i=ipart_start ; i<n_part_send ; i++) {
+            iPart = (*indexes_of_particles_to_exchange)[i];
+            int idir = 0;
+            int stride = 1;
+            for (idim=0 ; idim<ndim ; idim++) {
+                if ( cuParticles.position(idim,iPart) >= min_local[idim] )
+                    idir += ( cuParticles.position(idim,iPart) < max_local[idim] ) ? stride : 2*stride;
+                stride *= 3;
+            }
+            //If particle is outside of the global domain (has no neighbor), it will simply be deleted.
+            if ( direct_neighbor_[idir]!=MPI_PROC_NULL )
+                vecSpecies[ispec]->MPIbuff.direct_part_index_send[idir].push_back( iPart );
+        }
+        return;
+    }
+
     // Define where particles are going
     //Put particles in the send buffer it belongs to. Priority to lower dimensions.
-    for (int i=0 ; i<n_part_send ; i++) {
+    for (int i=ipart_start ; i<n_part_send ; i++) {
         iPart = (*indexes_of_particles_to_exchange)[i];
         check = 0;
         idim = 0;
@@ -477,10 +561,6 @@ void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim,
         if (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) {
             if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2))  {
                 MPI_Wait( &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[(iNeighbor+1)%2]) );
-                if (vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2]!=0) {
-                    //If I receive particles over MPI, I initialize my receive buffer with the appropriate size.
-                    vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2].initialize( vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2], cuParticles);
-                }
             }
         }
     }
@@ -508,14 +588,13 @@ void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim,
             }
             // Send particles
             if (is_a_MPI_neighbor(iDim, iNeighbor)) {
-                // If MPI comm, first copy particles in the sendbuffer
-                for (int iPart=0 ; iPart<n_part_send ; iPart++)
-                    cuParticles.cp_particle(vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart], vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]);
+                // If MPI comm, first pack particles in the send buffer
+                PackedParticles &sendBuffer = vecSpecies[ispec]->MPIbuff.partSendBuffer[iDim][iNeighbor];
+                cuParticles.pack( vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor], sendBuffer );
                 // Then send particles
                 int local_hindex = hindex - vecPatch->refHindex_;
                 int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor] = smpi->createMPIparticles( &(vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]) );
-                MPI_Isend( &((vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]).position(0,0)), 1, vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor], MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
+                MPI_Isend( &sendBuffer[0], sendBuffer.size(), MPI_BYTE, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
             }
             else {
                 //If not MPI comm, copy particles directly in the receive buffer
@@ -527,11 +606,12 @@ void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim,
         n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2];
         if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
             if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
-                // If MPI comm, receive particles in the recv buffer previously initialized.
-                vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor] = smpi->createMPIparticles( &(vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]) );
+                // If MPI comm, receive packed particles, unpacked in the species at the end of the comm (Species::sort_part)
+                PackedParticles &recvBuffer = vecSpecies[ispec]->MPIbuff.partRecvBuffer[iDim][(iNeighbor+1)%2];
+                recvBuffer.resize( cuParticles.packedSize( n_part_recv ) );
                 int local_hindex = neighbor_[iDim][(iNeighbor+1)%2] - smpi->patch_refHindexes[ MPI_neighbor_[iDim][(iNeighbor+1)%2] ];
                 int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                MPI_Irecv( &((vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).position(0,0)), 1, vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor], MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+                MPI_Irecv( &recvBuffer[0], recvBuffer.size(), MPI_BYTE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
             }
 
         } // END of Recv
@@ -573,13 +653,15 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
         if ( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && (n_part_send!=0) ) {
             if (is_a_MPI_neighbor(iDim, iNeighbor)) {
                 MPI_Wait( &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iNeighbor]) );
-                MPI_Type_free( &(vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor]) );
             }
         }
         if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
-            if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
+            // Particles received over MPI stay packed until they are unpacked in the species (Species::sort_part)
+            bool packed = is_a_MPI_neighbor(iDim, (iNeighbor+1)%2);
+            Particles &partRecv = vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2];
+            PackedParticles &packedRecv = vecSpecies[ispec]->MPIbuff.partRecvBuffer[iDim][(iNeighbor+1)%2];
+            if (packed) {
                 MPI_Wait( &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[(iNeighbor+1)%2]) );
-                MPI_Type_free( &(vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor]) );
             }
 
             // Treat diagonalParticles
@@ -588,33 +670,30 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
                     check = 0;
                     idim = iDim+1;//We check next dimension
                     while (check == 0 && idim<ndim){
+                        double position = packed ? packedRecv.position(idim,iPart) : partRecv.position(idim,iPart);
                         //If particle not in the domain...
-                        if ( (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).position(idim,iPart) < min_local[idim] ){
-                            if (neighbor_[idim][0]!=MPI_PROC_NULL){ //if neighbour exists
+                        if ( position < min_local[idim] || position >= max_local[idim] ){
+                            int side = ( position < min_local[idim] ) ? 0 : 1;
+                            if (neighbor_[idim][side]!=MPI_PROC_NULL){ //if neighbour exists
                                 //... copy it at the back of the local particle vector ...
-                                (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).cp_particle(iPart, cuParticles);
+                                if (packed) {
+                                    cuParticles.create_particle();
+                                    cuParticles.unpack_particle(packedRecv, iPart, cuParticles.size()-1);
+                                } else {
+                                    partRecv.cp_particle(iPart, cuParticles);
+                                }
                                 //...adjust bmax or cell_keys ...
                                 vecSpecies[ispec]->add_space_for_a_particle();
                                 //... and add its index to the particles to be sent later...
-                                vecSpecies[ispec]->MPIbuff.part_index_send[idim][0].push_back( cuParticles.size()-1 );
+                                vecSpecies[ispec]->MPIbuff.part_index_send[idim][side].push_back( cuParticles.size()-1 );
                                 //..without forgeting to add it to the list of particles to clean.
                                 vecSpecies[ispec]->addPartInExchList(cuParticles.size()-1);
                             }
                             //Remove it from receive buffer.
-                            (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).erase_particle(iPart);
-                            vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2]--;
-                            check = 1;
-                        }
-                        //Other side of idim
-                        else if ( (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).position(idim,iPart) >= max_local[idim]) {
-                            if (neighbor_[idim][1]!=MPI_PROC_NULL){ //if neighbour exists
-                                (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).cp_particle(iPart, cuParticles);
-                                //...adjust bmax or cell_keys ...
-                                vecSpecies[ispec]->add_space_for_a_particle();
-                                vecSpecies[ispec]->MPIbuff.part_index_send[idim][1].push_back( cuParticles.size()-1 );
-                                vecSpecies[ispec]->addPartInExchList(cuParticles.size()-1);
-                            }
-                            (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).erase_particle(iPart);
+                            if (packed)
+                                packedRecv.erase_particle(iPart);
+                            else
+                                partRecv.erase_particle(iPart);
                             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2]--;
                             check = 1;
                         }
@@ -638,24 +717,167 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
 } // finalizeCommParticles(... iDim)
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Direct exchange : start exchange of number of particles with all the neighbors, including edges and corners
+//   - a patch receives in direction idir what its neighbor idir sends in the opposite direction
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::initCommParticlesDirect(SmileiMPI* smpi, int ispec, Params& params, VectorPatch * vecPatch)
+{
+    SpeciesMPIbuffers &buff = vecSpecies[ispec]->MPIbuff;
+    int h0 = (*vecPatch)(0)->hindex;
+    int ndir = direct_neighbor_.size();
+
+    for (int idir=0 ; idir<ndir ; idir++) {
+        if (direct_neighbor_[idir]==MPI_PROC_NULL)
+            continue;
+        int odir = ndir-1-idir;
+
+        buff.direct_part_index_send_sz[idir] = buff.direct_part_index_send[idir].size();
+        if (is_a_direct_MPI_neighbor(idir)) {
+            int local_hindex = hindex - vecPatch->refHindex_;
+            int tag = buildtag( local_hindex, 4, 10+idir );
+            MPI_Isend( &(buff.direct_part_index_send_sz[idir]), 1, MPI_INT, direct_MPI_neighbor_[idir], tag, smpi->getParticleComm(), &(buff.direct_srequest[idir]) );
+
+            local_hindex = direct_neighbor_[idir] - smpi->patch_refHindexes[ direct_MPI_neighbor_[idir] ];
+            tag = buildtag( local_hindex, 4, 10+odir );
+            MPI_Irecv( &(buff.direct_part_index_recv_sz[idir]), 1, MPI_INT, direct_MPI_neighbor_[idir], tag, smpi->getParticleComm(), &(buff.direct_rrequest[idir]) );
+        }
+        else
+            (*vecPatch)( direct_neighbor_[idir]- h0 )->vecSpecies[ispec]->MPIbuff.direct_part_index_recv_sz[odir] = buff.direct_part_index_send_sz[idir];
+    }
+
+} // initCommParticlesDirect
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Direct exchange : finalize receive of number of particles and really send particles
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::CommParticlesDirect(SmileiMPI* smpi, int ispec, Params& params, VectorPatch * vecPatch)
+{
+    Particles &cuParticles = (*vecSpecies[ispec]->particles);
+    SpeciesMPIbuffers &buff = vecSpecies[ispec]->MPIbuff;
+    int h0 = (*vecPatch)(0)->hindex;
+    int ndir = direct_neighbor_.size();
+
+    for (int idir=0 ; idir<ndir ; idir++) {
+        if ( !is_a_direct_MPI_neighbor(idir) )
+            continue;
+        MPI_Status sstat, rstat;
+        MPI_Wait( &(buff.direct_srequest[idir]), &sstat );
+        MPI_Wait( &(buff.direct_rrequest[idir]), &rstat );
+    }
+
+    for (int idir=0 ; idir<ndir ; idir++) {
+        if (direct_neighbor_[idir]==MPI_PROC_NULL)
+            continue;
+        int odir = ndir-1-idir;
+        std::vector<int> &part_index_send = buff.direct_part_index_send[idir];
+        int n_part_send = part_index_send.size();
+
+        if (n_part_send!=0) {
+            // Enabled periodicity, along all the directions crossed
+            int jdir = idir;
+            for (int iDim=0 ; iDim<nDim_fields_ ; iDim++) {
+                int way = jdir%3 - 1;
+                jdir /= 3;
+                if ( (way==0) || (smpi->periods_[iDim]!=1) )
+                    continue;
+                double x_max = params.cell_length[iDim]*( params.n_space_global[iDim] );
+                for (int iPart=0 ; iPart<n_part_send ; iPart++) {
+                    if ( ( way==-1 ) && ( Pcoordinates[iDim] == 0 ) && ( cuParticles.position(iDim,part_index_send[iPart]) < 0. ) )
+                        cuParticles.position(iDim,part_index_send[iPart]) += x_max;
+                    else if ( ( way==1 ) && ( Pcoordinates[iDim] == params.number_of_patches[iDim]-1 ) && ( cuParticles.position(iDim,part_index_send[iPart]) >= x_max ) )
+                        cuParticles.position(iDim,part_index_send[iPart]) -= x_max;
+                }
+            }
+            if (is_a_direct_MPI_neighbor(idir)) {
+                cuParticles.pack( part_index_send, buff.direct_partSendBuffer[idir] );
+                int local_hindex = hindex - vecPatch->refHindex_;
+                int tag = buildtag( local_hindex, 4, 10+idir );
+                MPI_Isend( &(buff.direct_partSendBuffer[idir][0]), buff.direct_partSendBuffer[idir].size(), MPI_BYTE, direct_MPI_neighbor_[idir], tag, smpi->getParticleComm(), &(buff.direct_srequest[idir]) );
+            }
+            else {
+                //If not MPI comm, copy particles directly in the receive buffer
+                for (int iPart=0 ; iPart<n_part_send ; iPart++)
+                    cuParticles.cp_particle( part_index_send[iPart], (*vecPatch)( direct_neighbor_[idir]- h0 )->vecSpecies[ispec]->MPIbuff.direct_partRecv[odir] );
+            }
+        }
+
+        if ( is_a_direct_MPI_neighbor(idir) && (buff.direct_part_index_recv_sz[idir]!=0) ) {
+            int local_hindex = direct_neighbor_[idir] - smpi->patch_refHindexes[ direct_MPI_neighbor_[idir] ];
+            int tag = buildtag( local_hindex, 4, 10+odir );
+            buff.direct_partRecvBuffer[idir].resize( cuParticles.packedSize( buff.direct_part_index_recv_sz[idir] ) );
+            MPI_Irecv( &(buff.direct_partRecvBuffer[idir][0]), buff.direct_partRecvBuffer[idir].size(), MPI_BYTE, direct_MPI_neighbor_[idir], tag, smpi->getParticleComm(), &(buff.direct_rrequest[idir]) );
+        }
+    }
+
+} // END CommParticlesDirect
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Direct exchange : finalize receive of particles and store them at their definitive place (Species::sort_part, which
+// unpacks the particles received over MPI). No particle has to be forwarded, contrary to the exchange direction by
+// direction
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::finalizeCommParticlesDirect(SmileiMPI* smpi, int ispec, Params& params, VectorPatch * vecPatch)
+{
+    SpeciesMPIbuffers &buff = vecSpecies[ispec]->MPIbuff;
+
+    for (unsigned int idir=0 ; idir<direct_neighbor_.size() ; idir++) {
+        if ( !is_a_direct_MPI_neighbor(idir) )
+            continue;
+        MPI_Status sstat, rstat;
+        if (buff.direct_part_index_send[idir].size()!=0) {
+            MPI_Wait( &(buff.direct_srequest[idir]), &sstat );
+        }
+        if (buff.direct_part_index_recv_sz[idir]!=0) {
+            MPI_Wait( &(buff.direct_rrequest[idir]), &rstat );
+        }
+    }
+
+    vecSpecies[ispec]->sort_part(params);
+
+} // finalizeCommParticlesDirect
+
+
 void Patch::cleanParticlesOverhead(Params& params)
 {
     int ndim = params.nDim_field;
+    double high  = params.particles_capacity_watermarks[0];
+    double low   = params.particles_capacity_watermarks[1];
+    double decay = params.particles_capacity_decay;
     for (unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++) {
-        Particles &cuParticles = (*vecSpecies[ispec]->particles);
-
         for (int idim = 0; idim < ndim; idim++){
             for ( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
                 vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].clear();
-                vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].shrink_to_fit(ndim);
-                vecSpecies[ispec]->MPIbuff.partSend[idim][iNeighbor].clear();
-                vecSpecies[ispec]->MPIbuff.partSend[idim][iNeighbor].shrink_to_fit(ndim);
+                vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].manage_capacity(high, low, decay);
+                vecSpecies[ispec]->MPIbuff.partSendBuffer[idim][iNeighbor].manage_capacity(high, low, decay);
+                vecSpecies[ispec]->MPIbuff.partRecvBuffer[idim][iNeighbor].manage_capacity(high, low, decay);
                 vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor].clear();
                 vector<int>(vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor]).swap(vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor]);
             }
         }
+        for (unsigned int idir = 0 ; idir < direct_neighbor_.size() ; idir++) {
+            vecSpecies[ispec]->MPIbuff.direct_partRecv[idir].clear();
+            vecSpecies[ispec]->MPIbuff.direct_partRecv[idir].manage_capacity(high, low, decay);
+            vecSpecies[ispec]->MPIbuff.direct_partSendBuffer[idir].manage_capacity(high, low, decay);
+            vecSpecies[ispec]->MPIbuff.direct_partRecvBuffer[idir].manage_capacity(high, low, decay);
+            vecSpecies[ispec]->MPIbuff.direct_part_index_send[idir].clear();
+            vector<int>(vecSpecies[ispec]->MPIbuff.direct_part_index_send[idir]).swap(vecSpecies[ispec]->MPIbuff.direct_part_index_send[idir]);
+        }
 
-        cuParticles.shrink_to_fit(ndim);
+        // Both buffers of the cell-level sorting
+        vecSpecies[ispec]->particles_sorted[0].manage_capacity(high, low, decay);
+        vecSpecies[ispec]->particles_sorted[1].manage_capacity(high, low, decay);
+
+        // Buffers of created particles
+        if (vecSpecies[ispec]->Ionize)
+            vecSpecies[ispec]->Ionize->new_electrons.manage_capacity(high, low, decay);
+        if (vecSpecies[ispec]->Radiate)
+            vecSpecies[ispec]->Radiate->new_photons.manage_capacity(high, low, decay);
+        if (vecSpecies[ispec]->Multiphoton_Breit_Wheeler_process)
+            for (int k=0; k<2; k++)
+                vecSpecies[ispec]->Multiphoton_Breit_Wheeler_process->new_pair[k].manage_capacity(high, low, decay);
     }
 
 }
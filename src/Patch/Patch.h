@@ -29,6 +29,7 @@ class Patch
     friend class SimWindow;
     friend class SyncVectorPatch;
     friend class AsyncMPIbuffers;
+    friend class AggregatedMPIbuffers;
 public:
     //! Constructor for Patch
     Patch(Params& params, SmileiMPI* smpi, DomainDecomposition* domain_decomposition, unsigned int ipatch, unsigned int n_moved);
@@ -75,6 +76,9 @@ public:
     //! "fake" particles for the probe diagnostics
     std::vector<ProbeParticles*> probes;
 
+    //! Wall-clock time spent in the patch (dynamics, collisions, diags) since the last load balancing
+    double cost;
+
 
     // Geometrical description
     // -----------------------
@@ -90,14 +94,22 @@ public:
     //   - fields communication specified per geometry (pure virtual)
     // --------------------------------------------------------------
 
-    //! manage Idx of particles per direction,
-    void initExchParticles(SmileiMPI* smpi, int ispec, Params& params);
+    //! reset the exchange buffers of species ispec
+    void clearExchParticles(int ispec, Params& params);
+    //! manage Idx of particles per direction, from the ipart_start-th particle to exchange
+    void initExchParticles(SmileiMPI* smpi, int ispec, Params& params, unsigned int ipart_start);
     //!init comm  nbr of particles/
     void initCommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
     //! finalize comm / nbr of particles, init exch / particles
     void CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
     //! finalize exch / particles, manage particles suppr/introduce
     void finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
+    //! direct exchange (Main.direct_particle_exchange) : init comm / nbr of particles with all neighbors
+    void initCommParticlesDirect(SmileiMPI* smpi, int ispec, Params& params, VectorPatch* vecPatch);
+    //! direct exchange : finalize comm / nbr of particles, init exch / particles
+    void CommParticlesDirect(SmileiMPI* smpi, int ispec, Params& params, VectorPatch* vecPatch);
+    //! direct exchange : finalize exch / particles, manage particles suppr/introduce
+    void finalizeCommParticlesDirect(SmileiMPI* smpi, int ispec, Params& params, VectorPatch* vecPatch);
     //! clean memory resizing particles structure
     void cleanParticlesOverhead(Params& params);
     //! delete Particles included in the index of particles to exchange. Assumes indexes are sorted.
@@ -155,8 +167,11 @@ public:
     return false;
     }
 
+    //! Compute Ids of the face, edge and corner neighbors patch (direct_neighbor_)
+    void setDirectNeighbors(Params& params, DomainDecomposition* domain_decomposition);
     //! Compute MPI rank of neigbors patch regarding neigbors patch Ids
     void updateMPIenv(SmileiMPI *smpi);
+    //! Invalidate the persistent requests of the fields, set up for the previous neighbors and tags
     void updateTagenv(SmileiMPI *smpi);
 
     // Test who is MPI neighbor of current patch
@@ -164,6 +179,10 @@ public:
     return( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && (MPI_neighbor_[iDim][iNeighbor]!=MPI_me_) );
     }
 
+    inline bool is_a_direct_MPI_neighbor(int idir) {
+    return( (direct_neighbor_[idir]!=MPI_PROC_NULL) && (direct_MPI_neighbor_[idir]!=MPI_me_) );
+    }
+
     inline bool has_an_MPI_neighbor() {
         for ( unsigned int iDim=0 ; iDim<MPI_neighbor_.size() ; iDim++ ) {
             if ( ( MPI_neighbor_[iDim][0] != MPI_me_ ) &&  ( MPI_neighbor_[iDim][0]!= MPI_PROC_NULL ) )
@@ -245,6 +264,9 @@ public:
     //! MPI rank of current patch
     int MPI_me_;
 
+    //! Incremented each time the neighbors, their MPI rank or the tags change (see AsyncMPIbuffers::setupExchange)
+    unsigned int MPIenv_version_;
+
     //! The debye length, computed for collisions
     double debye_length_squared;
 
@@ -274,6 +296,13 @@ protected:
     //! MPI rank of neighbors patch
     std::vector< std::vector<int> > MPI_neighbor_, tmp_MPI_neighbor_;
 
+    //! Hilbert index of the face, edge and corner neighbors patch, used by the direct exchange of particles.
+    //! The neighbor shifted by d[i] = -1, 0 or 1 along each direction i is direct_neighbor_[ sum_i (d[i]+1) 3^i ],
+    //! the opposite direction of idir is direct_neighbor_.size()-1-idir
+    std::vector<int> direct_neighbor_, tmp_direct_neighbor_;
+    //! MPI rank of the face, edge and corner neighbors patch
+    std::vector<int> direct_MPI_neighbor_, tmp_direct_MPI_neighbor_;
+
     //! "Real" min limit of local sub-subdomain (ghost data not concerned)
     //!     - "0." on rank 0
     std::vector<double> min_local;
@@ -68,6 +68,9 @@ void Patch1D::initStep2(Params& params, DomainDecomposition* domain_decompositio
     if (params.EM_BCs[0][0]=="periodic" && xcall[0] >= (int)domain_decomposition->ndomain_[0])
         xcall[0] -= domain_decomposition->ndomain_[0];
     neighbor_[0][1] = domain_decomposition->getDomainId( xcall );
+
+    // All neighbors, including edges and corners
+    setDirectNeighbors( params, domain_decomposition );
     
     for (int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++) {
         ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
@@ -123,22 +126,32 @@ void Patch1D::initSumField( Field* field, int iDim, SmileiMPI* smpi )
         
     MPI_Datatype ntype = ntypeSum_[iDim][isDual[0]];
     
-    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+    // Persistent requests, set up again only when the MPI environment of the patch changes
+    if ( f1D->MPIbuff.setupSum( iDim, MPIenv_version_, f1D->data_ ) ) {
+        for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
             
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
-            istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + (1-iNeighbor) * ( 0 );
-            ix = (1-iDim)*istart;
-            int tag = f1D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.srequest[iDim][iNeighbor]) );
-        } // END of Send
+            if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + (1-iNeighbor) * ( 0 );
+                ix = (1-iDim)*istart;
+                int tag = f1D->MPIbuff.send_tags_[iDim][iNeighbor];
+                MPI_Send_init( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.sum_srequest[iDim][iNeighbor]) );
+            } // END of Send
             
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
-            int tmp_elem = f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
-            int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &( f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
-        } // END of Recv
+            if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+                int tmp_elem = f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
+                int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
+                MPI_Recv_init( &( f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]) );
+            } // END of Recv
             
-    } // END for iNeighbor
+        } // END for iNeighbor
+    }
+
+    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) )
+            MPI_Start( &(f1D->MPIbuff.sum_srequest[iDim][iNeighbor]) );
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) )
+            MPI_Start( &(f1D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]) );
+    }
     
 } // END initSumField
 
@@ -169,10 +182,10 @@ void Patch1D::finalizeSumField( Field* field, int iDim )
     
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
         if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
-            MPI_Wait( &(f1D->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
+            MPI_Wait( &(f1D->MPIbuff.sum_srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
         }
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
-            MPI_Wait( &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
+            MPI_Wait( &(f1D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
         }
     }
 
@@ -238,27 +251,37 @@ void Patch1D::initExchange( Field* field, int iDim, SmileiMPI* smpi )
     int istart, ix;
 
     MPI_Datatype ntype = ntype_[iDim][isDual[0]];
-    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+    // Persistent requests, set up again only when the MPI environment of the patch changes
+    if ( f1D->MPIbuff.setupExchange( iDim, MPIenv_version_, f1D->data_ ) ) {
+        for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
 
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+            if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
 
-            istart = iNeighbor * ( n_elem[iDim]- (2*oversize[iDim]+1+isDual[iDim]) ) + (1-iNeighbor) * ( oversize[iDim] + 1 + isDual[iDim] );
-            ix = (1-iDim)*istart;
-            int tag = f1D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.srequest[iDim][iNeighbor]) );
+                istart = iNeighbor * ( n_elem[iDim]- (2*oversize[iDim]+1+isDual[iDim]) ) + (1-iNeighbor) * ( oversize[iDim] + 1 + isDual[iDim] );
+                ix = (1-iDim)*istart;
+                int tag = f1D->MPIbuff.send_tags_[iDim][iNeighbor];
+                MPI_Send_init( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.srequest[iDim][iNeighbor]) );
 
-        } // END of Send
+            } // END of Send
 
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+            if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
 
-            istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1 - (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
-            ix = (1-iDim)*istart;
-            int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
+                istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1 - (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
+                ix = (1-iDim)*istart;
+                int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
+                MPI_Recv_init( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
 
-        } // END of Recv
+            } // END of Recv
 
-    } // END for iNeighbor
+        } // END for iNeighbor
+    }
+
+    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) )
+            MPI_Start( &(f1D->MPIbuff.srequest[iDim][iNeighbor]) );
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) )
+            MPI_Start( &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+    }
 
 } // END initExchange( Field* field, int iDim )
 
@@ -89,6 +89,9 @@ void Patch2D::initStep2(Params& params, DomainDecomposition* domain_decompositio
         xcall[1] -=  domain_decomposition->ndomain_[1];
     neighbor_[1][1] = domain_decomposition->getDomainId( xcall );
 
+    // All neighbors, including edges and corners
+    setDirectNeighbors( params, domain_decomposition );
+
     for (int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++) {
         for (int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++) {
             ntype_[0][ix_isPrim][iy_isPrim] = MPI_DATATYPE_NULL;
@@ -160,26 +163,36 @@ void Patch2D::initSumField( Field* field, int iDim, SmileiMPI* smpi )
         
     MPI_Datatype ntype = ntypeSum_[iDim][isDual[0]][isDual[1]];
         
-    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+    // Persistent requests, set up again only when the MPI environment of the patch changes
+    if ( f2D->MPIbuff.setupSum( iDim, MPIenv_version_, f2D->data_ ) ) {
+        for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
             
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
-            istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + (1-iNeighbor) * ( 0 );
-            ix = (1-iDim)*istart;
-            iy =    iDim *istart;
-            int tag = f2D->MPIbuff.send_tags_[iDim][iNeighbor];
-            //cout << hindex << " send to " << neighbor_[iDim][iNeighbor] << endl;
-            MPI_Isend( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.srequest[iDim][iNeighbor]) );
-        } // END of Send
+            if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + (1-iNeighbor) * ( 0 );
+                ix = (1-iDim)*istart;
+                iy =    iDim *istart;
+                int tag = f2D->MPIbuff.send_tags_[iDim][iNeighbor];
+                //cout << hindex << " send to " << neighbor_[iDim][iNeighbor] << endl;
+                MPI_Send_init( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.sum_srequest[iDim][iNeighbor]) );
+            } // END of Send
             
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
-            int tmp_elem = f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
-            int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            //cout << hindex << " recv from " << neighbor_[iDim][(iNeighbor+1)%2] << " ; n_elements = " << tmp_elem << endl;
-            MPI_Irecv( &( f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+            if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+                int tmp_elem = f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
+                int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
+                //cout << hindex << " recv from " << neighbor_[iDim][(iNeighbor+1)%2] << " ; n_elements = " << tmp_elem << endl;
+                MPI_Recv_init( &( f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]) );
 
-        } // END of Recv
+            } // END of Recv
             
-    } // END for iNeighbor
+        } // END for iNeighbor
+    }
+
+    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) )
+            MPI_Start( &(f2D->MPIbuff.sum_srequest[iDim][iNeighbor]) );
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) )
+            MPI_Start( &(f2D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]) );
+    }
 
 } // END initSumField
 
@@ -216,11 +229,11 @@ void Patch2D::finalizeSumField( Field* field, int iDim )
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
         if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
             //cout << hindex << " is waiting for send at " << neighbor_[iDim][iNeighbor] << endl;
-            MPI_Wait( &(f2D->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
+            MPI_Wait( &(f2D->MPIbuff.sum_srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
         }
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             //cout << hindex << " is waiting for recv from " << neighbor_[iDim][(iNeighbor+1)%2] << endl;        
-            MPI_Wait( &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
+            MPI_Wait( &(f2D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
         }
     }
 
@@ -306,31 +319,41 @@ void Patch2D::initExchange( Field* field, int iDim, SmileiMPI* smpi )
     int istart, ix, iy;
 
     MPI_Datatype ntype = ntype_[iDim][isDual[0]][isDual[1]];
-    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+    // Persistent requests, set up again only when the MPI environment of the patch changes
+    if ( f2D->MPIbuff.setupExchange( iDim, MPIenv_version_, f2D->data_ ) ) {
+        for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
 
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+            if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
 
-            istart = iNeighbor * ( n_elem[iDim]- (2*oversize[iDim]+1+isDual[iDim]) ) + (1-iNeighbor) * ( oversize[iDim] + 1 + isDual[iDim] );
-            ix = (1-iDim)*istart;
-            iy =    iDim *istart;
-            int tag = f2D->MPIbuff.send_tags_[iDim][iNeighbor];
-            //cout << MPI_me_ << " Isend to " << MPI_neighbor_[iDim][iNeighbor] << " with tag " << tag << " \t name = " << field->name << endl;
-            MPI_Isend( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.srequest[iDim][iNeighbor]) );
+                istart = iNeighbor * ( n_elem[iDim]- (2*oversize[iDim]+1+isDual[iDim]) ) + (1-iNeighbor) * ( oversize[iDim] + 1 + isDual[iDim] );
+                ix = (1-iDim)*istart;
+                iy =    iDim *istart;
+                int tag = f2D->MPIbuff.send_tags_[iDim][iNeighbor];
+                //cout << MPI_me_ << " Isend to " << MPI_neighbor_[iDim][iNeighbor] << " with tag " << tag << " \t name = " << field->name << endl;
+                MPI_Send_init( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.srequest[iDim][iNeighbor]) );
 
-        } // END of Send
+            } // END of Send
 
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+            if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
 
-            istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1- (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
-            ix = (1-iDim)*istart;
-            iy =    iDim *istart;
-            int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            //cout << MPI_me_  << " Irecv " << MPI_neighbor_[iDim][(iNeighbor+1)%2] << " with tag " << tag << " \t name = " << field->name << endl;
-            MPI_Irecv( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
+                istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1- (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
+                ix = (1-iDim)*istart;
+                iy =    iDim *istart;
+                int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
+                //cout << MPI_me_  << " Irecv " << MPI_neighbor_[iDim][(iNeighbor+1)%2] << " with tag " << tag << " \t name = " << field->name << endl;
+                MPI_Recv_init( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
 
-        } // END of Recv
+            } // END of Recv
 
-    } // END for iNeighbor
+        } // END for iNeighbor
+    }
+
+    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) )
+            MPI_Start( &(f2D->MPIbuff.srequest[iDim][iNeighbor]) );
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) )
+            MPI_Start( &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+    }
 
 
 } // END initExchange( Field* field, int iDim )
@@ -112,6 +112,9 @@ void Patch3D::initStep2(Params& params, DomainDecomposition* domain_decompositio
         xcall[2] -= domain_decomposition->ndomain_[2];
     neighbor_[2][1] =  domain_decomposition->getDomainId( xcall );
 
+    // All neighbors, including edges and corners
+    setDirectNeighbors( params, domain_decomposition );
+
     for (int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++) {
         for (int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++) {
             for (int iz_isPrim=0 ; iz_isPrim<2 ; iz_isPrim++) {
@@ -191,26 +194,36 @@ void Patch3D::initSumField( Field* field, int iDim, SmileiMPI* smpi )
         
     MPI_Datatype ntype = ntypeSum_[iDim][isDual[0]][isDual[1]][isDual[2]];
         
-    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+    // Persistent requests, set up again only when the MPI environment of the patch changes
+    if ( f3D->MPIbuff.setupSum( iDim, MPIenv_version_, f3D->data_ ) ) {
+        for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
             
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
-            istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + (1-iNeighbor) * ( 0 );
-            ix = idx[0]*istart;
-            iy = idx[1]*istart;
-            iz = idx[2]*istart;
-            int tag = f3D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.srequest[iDim][iNeighbor]) );
-        } // END of Send
+            if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + (1-iNeighbor) * ( 0 );
+                ix = idx[0]*istart;
+                iy = idx[1]*istart;
+                iz = idx[2]*istart;
+                int tag = f3D->MPIbuff.send_tags_[iDim][iNeighbor];
+                MPI_Send_init( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, 
+                           MPI_COMM_WORLD, &(f3D->MPIbuff.sum_srequest[iDim][iNeighbor]) );
+            } // END of Send
             
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
-            int tmp_elem = f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
-            int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &( f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0] ), tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
-        } // END of Recv
+            if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+                int tmp_elem = f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
+                int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
+                MPI_Recv_init( &( f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0] ), tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
+                           MPI_COMM_WORLD, &(f3D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]) );
+            } // END of Recv
             
-    } // END for iNeighbor
+        } // END for iNeighbor
+    }
+
+    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) )
+            MPI_Start( &(f3D->MPIbuff.sum_srequest[iDim][iNeighbor]) );
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) )
+            MPI_Start( &(f3D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]) );
+    }
 
 } // END initSumField
 
@@ -248,10 +261,10 @@ void Patch3D::finalizeSumField( Field* field, int iDim )
         
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
         if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
-            MPI_Wait( &(f3D->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
+            MPI_Wait( &(f3D->MPIbuff.sum_srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
         }
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
-            MPI_Wait( &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
+            MPI_Wait( &(f3D->MPIbuff.sum_rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
         }
     }
     
@@ -344,33 +357,43 @@ void Patch3D::initExchange( Field* field, int iDim, SmileiMPI* smpi )
     int istart, ix, iy, iz;
 
     MPI_Datatype ntype = ntype_[iDim][isDual[0]][isDual[1]][isDual[2]];
-    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+    // Persistent requests, set up again only when the MPI environment of the patch changes
+    if ( f3D->MPIbuff.setupExchange( iDim, MPIenv_version_, f3D->data_ ) ) {
+        for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
 
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+            if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
 
-            istart = iNeighbor * ( n_elem[iDim]- (2*oversize[iDim]+1+isDual[iDim]) ) + (1-iNeighbor) * ( oversize[iDim] + 1 + isDual[iDim] );
-            ix = idx[0]*istart;
-            iy = idx[1]*istart;
-            iz = idx[2]*istart;
-            int tag = f3D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.srequest[iDim][iNeighbor]) );
+                istart = iNeighbor * ( n_elem[iDim]- (2*oversize[iDim]+1+isDual[iDim]) ) + (1-iNeighbor) * ( oversize[iDim] + 1 + isDual[iDim] );
+                ix = idx[0]*istart;
+                iy = idx[1]*istart;
+                iz = idx[2]*istart;
+                int tag = f3D->MPIbuff.send_tags_[iDim][iNeighbor];
+                MPI_Send_init( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, 
+                           MPI_COMM_WORLD, &(f3D->MPIbuff.srequest[iDim][iNeighbor]) );
 
-        } // END of Send
+            } // END of Send
 
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+            if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
 
-            istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1- (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
-            ix = idx[0]*istart;
-            iy = idx[1]*istart;
-            iz = idx[2]*istart;
-            int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
+                istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1- (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
+                ix = idx[0]*istart;
+                iy = idx[1]*istart;
+                iz = idx[2]*istart;
+                int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
+                MPI_Recv_init( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
+                           MPI_COMM_WORLD, &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
 
-        } // END of Recv
+            } // END of Recv
 
-    } // END for iNeighbor
+        } // END for iNeighbor
+    }
+
+    for (int iNeighbor=0 ; iNeighbor<patch_nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) )
+            MPI_Start( &(f3D->MPIbuff.srequest[iDim][iNeighbor]) );
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) )
+            MPI_Start( &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+    }
 
 
 } // END initExchange( Field* field, int iDim )
@@ -6,9 +6,38 @@
 #include "VectorPatch.h"
 #include "Params.h"
 #include "SmileiMPI.h"
+#include "AggregatedMPIbuffers.h"
 
 using namespace std;
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Ghost cells of fields (all patches) along the directions dims sent in a single message per neighbor MPI process
+// (Main.aggregate_ghost_messages). Return false if the messages are not aggregated : per patch communications.
+// ---------------------------------------------------------------------------------------------------------------------
+static bool initAggregated( vector<Field*>& fields, vector<unsigned int> dims, int kind, VectorPatch& vecPatches, SmileiMPI* smpi )
+{
+    AggregatedMPIbuffers* aggregated = vecPatches.aggregatedBuffers( fields, dims, kind );
+    if (aggregated)
+        aggregated->init( fields, dims, kind, vecPatches, smpi );
+    return aggregated!=NULL;
+}
+
+static bool finalizeAggregated( vector<Field*>& fields, vector<unsigned int> dims, int kind, VectorPatch& vecPatches )
+{
+    AggregatedMPIbuffers* aggregated = vecPatches.aggregatedBuffers( fields, dims, kind );
+    if (aggregated)
+        aggregated->finalize();
+    return aggregated!=NULL;
+}
+
+static vector<unsigned int> allDirections( vector<Field*>& fields )
+{
+    vector<unsigned int> dims( fields[0]->dims_.size() );
+    for (unsigned int iDim=0 ; iDim<dims.size() ; iDim++)
+        dims[iDim] = iDim;
+    return dims;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // ----------------------------------------------       PARTICLES         ----------------------------------------------
@@ -17,40 +46,35 @@ using namespace std;
 
 void SyncVectorPatch::exchangeParticles(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime)
 {
-    #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        vecPatches(ipatch)->initExchParticles(smpi, ispec, params);
-    }
-
-    // Per direction
-    for (unsigned int iDim=0 ; iDim<1 ; iDim++) {
+    // Particles going out along the first direction (or in any direction for the direct
+    // exchange) were split and their number sent during the dynamics (VectorPatch::dynamics_species) :
+    // send them now, they are received during the resolution of the Maxwell equations
+    if (params.direct_particle_exchange) {
         #pragma omp for schedule(runtime)
         for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-            vecPatches(ipatch)->initCommParticles(smpi, ispec, params, iDim, &vecPatches);
+            vecPatches(ipatch)->CommParticlesDirect(smpi, ispec, params, &vecPatches);
         }
-
-        //#pragma omp for schedule(runtime)
-        //for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        //    vecPatches(ipatch)->CommParticles(smpi, ispec, params, iDim, &vecPatches);
-        //}
-        //#pragma omp for schedule(runtime)
-        //for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        //    vecPatches(ipatch)->finalizeCommParticles(smpi, ispec, params, iDim, &vecPatches);
-        //}
+        return;
     }
 
-    //#pragma omp for schedule(runtime)
-    //for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
-    //    vecPatches(ipatch)->vecSpecies[ispec]->sort_part();
+    #pragma omp for schedule(runtime)
+    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+        vecPatches(ipatch)->CommParticles(smpi, ispec, params, 0, &vecPatches);
+    }
 }
 
 
 void SyncVectorPatch::finalize_and_sort_parts(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime)
 {
-    #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        vecPatches(ipatch)->CommParticles(smpi, ispec, params, 0, &vecPatches);
+    // Direct exchange : a single round, no particle to forward along the next directions
+    if (params.direct_particle_exchange) {
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+            vecPatches(ipatch)->finalizeCommParticlesDirect(smpi, ispec, params, &vecPatches);
+        }
+        return;
     }
+
     #pragma omp for schedule(runtime)
     for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
         vecPatches(ipatch)->finalizeCommParticles(smpi, ispec, params, 0, &vecPatches);
@@ -159,10 +183,12 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
     // Sum per direction :
 
     // iDim = 0, initialize comms : Isend/Irecv
-    #pragma omp for schedule(static)
-    for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
-        unsigned int ipatch = ifield%nPatches;
-        vecPatches(ipatch)->initSumField( fields[ifield], 0, smpi );
+    if ( !initAggregated( fields, vector<unsigned int>(1,0), AggregatedMPIbuffers::sum, vecPatches, smpi ) ) {
+        #pragma omp for schedule(static)
+        for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
+            unsigned int ipatch = ifield%nPatches;
+            vecPatches(ipatch)->initSumField( fields[ifield], 0, smpi );
+        }
     }
 
     // iDim = 0, local
@@ -192,6 +218,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
     }
 
     // iDim = 0, finalize (waitall)
+    // Aggregated messages are received in the buffers of the fields, summed as the per patch ones
+    finalizeAggregated( fields, vector<unsigned int>(1,0), AggregatedMPIbuffers::sum, vecPatches );
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
         unsigned int ipatch = ifield%nPatches;
@@ -205,10 +233,12 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
         // Sum per direction :
 
         // iDim = 1, initialize comms : Isend/Irecv
-        #pragma omp for schedule(static)
-        for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
-            unsigned int ipatch = ifield%nPatches;
-            vecPatches(ipatch)->initSumField( fields[ifield], 1, smpi );
+        if ( !initAggregated( fields, vector<unsigned int>(1,1), AggregatedMPIbuffers::sum, vecPatches, smpi ) ) {
+            #pragma omp for schedule(static)
+            for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
+                unsigned int ipatch = ifield%nPatches;
+                vecPatches(ipatch)->initSumField( fields[ifield], 1, smpi );
+            }
         }
 
         // iDim = 1, local
@@ -242,6 +272,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
         }
 
         // iDim = 1, finalize (waitall)
+        // Aggregated messages are received in the buffers of the fields, summed as the per patch ones
+        finalizeAggregated( fields, vector<unsigned int>(1,1), AggregatedMPIbuffers::sum, vecPatches );
         #pragma omp for schedule(static)
         for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
             unsigned int ipatch = ifield%nPatches;
@@ -255,10 +287,12 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
             // Sum per direction :
 
             // iDim = 2, initialize comms : Isend/Irecv
-            #pragma omp for schedule(static)
-            for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
-                unsigned int ipatch = ifield%nPatches;
-                vecPatches(ipatch)->initSumField( fields[ifield], 2, smpi );
+            if ( !initAggregated( fields, vector<unsigned int>(1,2), AggregatedMPIbuffers::sum, vecPatches, smpi ) ) {
+                #pragma omp for schedule(static)
+                for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
+                    unsigned int ipatch = ifield%nPatches;
+                    vecPatches(ipatch)->initSumField( fields[ifield], 2, smpi );
+                }
             }
 
             // iDim = 2 local
@@ -294,6 +328,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
             }
 
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
+            // Aggregated messages are received in the buffers of the fields, summed as the per patch ones
+            finalizeAggregated( fields, vector<unsigned int>(1,2), AggregatedMPIbuffers::sum, vecPatches );
             #pragma omp for schedule(static)
             for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
                 unsigned int ipatch = ifield%nPatches;
@@ -341,12 +377,14 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
 
     // iDim = 0, initialize comms : Isend/Irecv
     unsigned int nPatchMPIx = vecPatches.MPIxIdx.size();
-    #pragma omp for schedule(static)
-    for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi ); // Jx
-        vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi ); // Jy
-        vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi ); // Jz
+    if ( !initAggregated( fields, vector<unsigned int>(1,0), AggregatedMPIbuffers::sum, vecPatches, smpi ) ) {
+        #pragma omp for schedule(static)
+        for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIxIdx[ifield];
+            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi ); // Jx
+            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi ); // Jy
+            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi ); // Jz
+        }
     }
     // iDim = 0, local
     int nFieldLocalx = vecPatches.densitiesLocalx.size()/3;
@@ -381,6 +419,7 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
     }
 
     // iDim = 0, finalize (waitall)
+    finalizeAggregated( fields, vector<unsigned int>(1,0), AggregatedMPIbuffers::sum, vecPatches );
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
         unsigned int ipatch = vecPatches.MPIxIdx[ifield];
@@ -397,12 +436,14 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
 
         // iDim = 1, initialize comms : Isend/Irecv
         unsigned int nPatchMPIy = vecPatches.MPIyIdx.size();
-        #pragma omp for schedule(static)
-        for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield++) {
-            unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi ); // Jx
-            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi ); // Jy
-            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi ); // Jz
+        if ( !initAggregated( fields, vector<unsigned int>(1,1), AggregatedMPIbuffers::sum, vecPatches, smpi ) ) {
+            #pragma omp for schedule(static)
+            for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield++) {
+                unsigned int ipatch = vecPatches.MPIyIdx[ifield];
+                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi ); // Jx
+                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi ); // Jy
+                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi ); // Jz
+            }
         }
 
         // iDim = 1,
@@ -442,6 +483,7 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
         }
 
         // iDim = 1, finalize (waitall)
+        finalizeAggregated( fields, vector<unsigned int>(1,1), AggregatedMPIbuffers::sum, vecPatches );
         #pragma omp for schedule(static)
         for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield=ifield+1) {
             unsigned int ipatch = vecPatches.MPIyIdx[ifield];
@@ -458,12 +500,14 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
 
             // iDim = 2, initialize comms : Isend/Irecv
             unsigned int nPatchMPIz = vecPatches.MPIzIdx.size();
-            #pragma omp for schedule(static)
-            for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield++) {
-                unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi ); // Jx
-                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi ); // Jy
-                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi ); // Jz
+            if ( !initAggregated( fields, vector<unsigned int>(1,2), AggregatedMPIbuffers::sum, vecPatches, smpi ) ) {
+                #pragma omp for schedule(static)
+                for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield++) {
+                    unsigned int ipatch = vecPatches.MPIzIdx[ifield];
+                    vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi ); // Jx
+                    vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi ); // Jy
+                    vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi ); // Jz
+                }
             }
 
             // iDim = 2 local
@@ -506,6 +550,7 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
             }
 
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
+            finalizeAggregated( fields, vector<unsigned int>(1,2), AggregatedMPIbuffers::sum, vecPatches );
             #pragma omp for schedule(static)
             for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield=ifield+1) {
                 unsigned int ipatch = vecPatches.MPIzIdx[ifield];
@@ -659,11 +704,13 @@ void SyncVectorPatch::finalizeexchangeJ( Params& params, VectorPatch& vecPatches
 // timers and itime were here introduced for debugging
 void SyncVectorPatch::exchange_along_all_directions( std::vector<Field*> fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
-    for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
-        #pragma omp for schedule(static)
-        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-            vecPatches(ipatch)->initExchange( fields[ipatch], iDim, smpi );
-    } // End for iDim
+    if ( !initAggregated( fields, allDirections( fields ), AggregatedMPIbuffers::exchange, vecPatches, smpi ) ) {
+        for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+            #pragma omp for schedule(static)
+            for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+                vecPatches(ipatch)->initExchange( fields[ipatch], iDim, smpi );
+        } // End for iDim
+    }
 
 
     unsigned int nx_, ny_(1), nz_(1), h0, oversize[3], n_space[3], gsp[3];
@@ -735,6 +782,9 @@ void SyncVectorPatch::exchange_along_all_directions( std::vector<Field*> fields,
 // MPI_Wait for all communications initialised in exchange_along_all_directions
 void SyncVectorPatch::finalize_exchange_along_all_directions( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    if ( finalizeAggregated( fields, allDirections( fields ), AggregatedMPIbuffers::exchange, vecPatches ) )
+        return;
+
     for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
         #pragma omp for schedule(static)
         for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
@@ -954,12 +1004,14 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field*> f
 //     - These fields are identified with lists of index MPIxIdx and LocalxIdx
 void SyncVectorPatch::exchange_all_components_along_X( std::vector<Field*>& fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
-    unsigned int nMPIx = vecPatches.MPIxIdx.size();
-    #pragma omp for schedule(static)
-    for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
-        vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
+    if ( !initAggregated( fields, vector<unsigned int>(1,0), AggregatedMPIbuffers::exchange, vecPatches, smpi ) ) {
+        unsigned int nMPIx = vecPatches.MPIxIdx.size();
+        #pragma omp for schedule(static)
+        for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIxIdx[ifield];
+            vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
+            vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
+        }
     }
 
 
@@ -1008,6 +1060,9 @@ void SyncVectorPatch::exchange_all_components_along_X( std::vector<Field*>& fiel
 // MPI_Wait for all communications initialised in exchange_all_components_along_X
 void SyncVectorPatch::finalize_exchange_all_components_along_X( std::vector<Field*>& fields, VectorPatch& vecPatches )
 {
+    if ( finalizeAggregated( fields, vector<unsigned int>(1,0), AggregatedMPIbuffers::exchange, vecPatches ) )
+        return;
+
     unsigned int nMPIx = vecPatches.MPIxIdx.size();
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
@@ -1027,12 +1082,14 @@ void SyncVectorPatch::finalize_exchange_all_components_along_X( std::vector<Fiel
 //     - These fields are identified with lists of index MPIyIdx and LocalyIdx
 void SyncVectorPatch::exchange_all_components_along_Y( std::vector<Field*>& fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
-    unsigned int nMPIy = vecPatches.MPIyIdx.size();
-    #pragma omp for schedule(static)
-    for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-        vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi );   // Bx
-        vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
+    if ( !initAggregated( fields, vector<unsigned int>(1,1), AggregatedMPIbuffers::exchange, vecPatches, smpi ) ) {
+        unsigned int nMPIy = vecPatches.MPIyIdx.size();
+        #pragma omp for schedule(static)
+        for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIyIdx[ifield];
+            vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi );   // Bx
+            vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
+        }
     }
 
     unsigned int h0, oversize, n_space;
@@ -1083,6 +1140,9 @@ void SyncVectorPatch::exchange_all_components_along_Y( std::vector<Field*>& fiel
 // MPI_Wait for all communications initialised in exchange_all_components_along_Y
 void SyncVectorPatch::finalize_exchange_all_components_along_Y( std::vector<Field*>& fields, VectorPatch& vecPatches )
 {
+    if ( finalizeAggregated( fields, vector<unsigned int>(1,1), AggregatedMPIbuffers::exchange, vecPatches ) )
+        return;
+
     unsigned int nMPIy = vecPatches.MPIyIdx.size();
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
@@ -1104,12 +1164,14 @@ void SyncVectorPatch::finalize_exchange_all_components_along_Y( std::vector<Fiel
 //     - These fields are identified with lists of index MPIzIdx and LocalzIdx
 void SyncVectorPatch::exchange_all_components_along_Z( std::vector<Field*> fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
-    unsigned int nMPIz = vecPatches.MPIzIdx.size();
-    #pragma omp for schedule(static)
-    for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-        vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi ); // Bx
-        vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
+    if ( !initAggregated( fields, vector<unsigned int>(1,2), AggregatedMPIbuffers::exchange, vecPatches, smpi ) ) {
+        unsigned int nMPIz = vecPatches.MPIzIdx.size();
+        #pragma omp for schedule(static)
+        for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIzIdx[ifield];
+            vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi ); // Bx
+            vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
+        }
     }
 
     unsigned int h0, oversize, n_space;
@@ -1158,6 +1220,9 @@ void SyncVectorPatch::exchange_all_components_along_Z( std::vector<Field*> field
 // MPI_Wait for all communications initialised in exchange_all_components_along_Z
 void SyncVectorPatch::finalize_exchange_all_components_along_Z( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    if ( finalizeAggregated( fields, vector<unsigned int>(1,2), AggregatedMPIbuffers::exchange, vecPatches ) )
+        return;
+
     unsigned int nMPIz = vecPatches.MPIzIdx.size();
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
@@ -19,6 +19,7 @@
 #include "DiagnosticFactory.h"
 
 #include "SyncVectorPatch.h"
+#include "AggregatedMPIbuffers.h"
 #include "interface.h"
 #include "Timers.h"
 
@@ -28,12 +29,14 @@ using namespace std;
 VectorPatch::VectorPatch()
 {
     domain_decomposition_ = NULL ;
+    aggregate_ghost_messages_ = false;
 }
 
 
 VectorPatch::VectorPatch( Params& params )
 {
     domain_decomposition_ = DomainDecompositionFactory::create( params );
+    aggregate_ghost_messages_ = params.aggregate_ghost_messages;
 }
 
 
@@ -70,12 +73,41 @@ void VectorPatch::close(SmileiMPI * smpiData)
         delete globalDiags[idiag];
     globalDiags.clear();
 
+    clearAggregatedBuffers();
+
     for (unsigned int ipatch=0 ; ipatch<size(); ipatch++)
         delete patches_[ipatch];
 
     patches_.clear();
 }
 
+
+AggregatedMPIbuffers* VectorPatch::aggregatedBuffers( vector<Field*>& fields, vector<unsigned int>& dims, int kind )
+{
+    if ( !aggregate_ghost_messages_ )
+        return NULL;
+
+    string phase = AggregatedMPIbuffers::phase( fields, dims, kind, size() );
+    AggregatedMPIbuffers* buffers;
+    #pragma omp critical
+    {
+        AggregatedMPIbuffers*& b = aggregated_buffers_[ phase ];
+        if ( b == NULL )
+            b = new AggregatedMPIbuffers();
+        buffers = b;
+    }
+    return buffers;
+}
+
+
+void VectorPatch::clearAggregatedBuffers()
+{
+    for (map<string, AggregatedMPIbuffers*>::iterator it=aggregated_buffers_.begin() ; it!=aggregated_buffers_.end() ; it++)
+        delete it->second;
+    aggregated_buffers_.clear();
+    FieldArena::detachAll();
+}
+
 void VectorPatch::createDiags(Params& params, SmileiMPI* smpi, OpenPMDparams& openPMD)
 {
     globalDiags = DiagnosticFactory::createGlobalDiagnostics(params, smpi, *this );
@@ -143,22 +175,34 @@ void VectorPatch::dynamics(Params& params,
     #pragma omp single
     diag_flag = needsRhoJsNow(itime);
 
+    // The currents and densities of species are only allocated on the timesteps which need them
+    if (diag_flag) {
+        #pragma omp for schedule(static)
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++)
+            (*this)(ipatch)->EMfields->allocateRhoJs();
+    }
+
     timers.particles.restart();
     ostringstream t;
+
+    // The neighbors set the number of particles to receive during their dynamics
+    #pragma omp for schedule(runtime)
+    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) )
+                (*this)(ipatch)->clearExchParticles(ispec, params);
+        }
+    }
+
     #pragma omp for schedule(runtime)
     for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+        double t0 = MPI_Wtime();
         (*this)(ipatch)->EMfields->restartRhoJ();
         for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
-            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
-                species(ipatch, ispec)->dynamics(time_dual, ispec,
-                                                 emfields(ipatch), interp(ipatch), proj(ipatch),
-                                                 params, diag_flag, partwalls(ipatch),
-                                                 (*this)(ipatch), smpi,
-                                                 RadiationTables,
-                                                 MultiphotonBreitWheelerTables,
-                                                 localDiags);
-            }
+            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  )
+                dynamics_species( ipatch, ispec, params, smpi, simWindow, RadiationTables, MultiphotonBreitWheelerTables, time_dual, itime );
         }
+        (*this)(ipatch)->cost += MPI_Wtime() - t0;
 
     }
     timers.particles.update( params.printNow( itime ) );
@@ -173,6 +217,86 @@ void VectorPatch::dynamics(Params& params,
 
 } // END dynamics
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Dynamics of species ispec in patch ipatch, with its own random stream
+// The boundary bins are pushed first, then the exchange of the particles going out along the first direction is
+// initiated, and the interior bins are pushed while the number of particles to exchange is sent to the neighbors
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::dynamics_species(unsigned int ipatch, unsigned int ispec, Params& params, SmileiMPI* smpi, SimWindow* simWindow,
+                                   RadiationTables & RadiationTables,
+                                   MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
+                                   double time_dual, int itime)
+{
+    Species* spec = species(ipatch, ispec);
+    Rand::setStream( (*this)(ipatch)->Hindex(), ispec, itime );
+    spec->dynamics(time_dual, ispec,
+                   emfields(ipatch), interp(ipatch), proj(ipatch),
+                   params, diag_flag, partwalls(ipatch),
+                   (*this)(ipatch), smpi,
+                   RadiationTables,
+                   MultiphotonBreitWheelerTables,
+                   localDiags, Species::boundary_bins);
+
+    // Frozen species : all the bins have been processed
+    if ( !spec->isProj(time_dual, simWindow) )
+        return;
+
+    // A particle moves by less than a cell per timestep : only those of the boundary bins can go out along x
+    if (!params.direct_particle_exchange) {
+        (*this)(ipatch)->initExchParticles(smpi, ispec, params, 0);
+        (*this)(ipatch)->initCommParticles(smpi, ispec, params, 0, this);
+    }
+
+    unsigned int n_boundary = spec->indexes_of_particles_to_exchange.size();
+    spec->dynamics(time_dual, ispec,
+                   emfields(ipatch), interp(ipatch), proj(ipatch),
+                   params, diag_flag, partwalls(ipatch),
+                   (*this)(ipatch), smpi,
+                   RadiationTables,
+                   MultiphotonBreitWheelerTables,
+                   localDiags, Species::interior_bins);
+
+    // Particles of the interior bins going out along the other directions,
+    // or all the particles going out for the direct exchange with the face, edge and corner neighbors
+    if (!params.direct_particle_exchange)
+        (*this)(ipatch)->initExchParticles(smpi, ispec, params, n_boundary);
+    else {
+        (*this)(ipatch)->initExchParticles(smpi, ispec, params, 0);
+        (*this)(ipatch)->initCommParticlesDirect(smpi, ispec, params, this);
+    }
+
+    // The first bin comes before the interior ones in the list : keep the indexes sorted for Species::sort_part
+    std::vector<int>& indexes = spec->indexes_of_particles_to_exchange;
+    if ( indexes.size() > n_boundary ) {
+        unsigned int n_first = std::lower_bound( indexes.begin(), indexes.begin()+n_boundary, spec->bmin[1] ) - indexes.begin();
+        std::rotate( indexes.begin()+n_first, indexes.begin()+n_boundary, indexes.end() );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Import the particles created by species ispec in patch ipatch, then merge and sort its particles if needed
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::finalize_species(unsigned int ipatch, unsigned int ispec, Params& params, SmileiMPI* smpi,
+                                   RadiationTables & RadiationTables,
+                                   MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
+                                   double time_dual, int itime)
+{
+    species(ipatch, ispec)->dynamics_import_particles(time_dual, ispec,
+                                                      params,
+                                                      (*this)(ipatch), smpi,
+                                                      RadiationTables,
+                                                      MultiphotonBreitWheelerTables,
+                                                      localDiags);
+
+    // Macro-particle merging
+    if ( species(ipatch, ispec)->Merge && species(ipatch, ispec)->merge_every > 0 && itime%species(ipatch, ispec)->merge_every==0 )
+        species(ipatch, ispec)->merge_particles();
+
+    // Cell-level sorting of the particles
+    if ( species(ipatch, ispec)->cell_sort_every > 0 && itime%species(ipatch, ispec)->cell_sort_every==0 )
+        species(ipatch, ispec)->count_sort_part(params);
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all patches, project charge and current densities with standard scheme for diag purposes at t=0 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -217,15 +341,8 @@ void VectorPatch::finalize_and_sort_parts(Params& params, SmileiMPI* smpi, SimWi
     for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
         // Particle importation for all species
         for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
-            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
-
-                species(ipatch, ispec)->dynamics_import_particles(time_dual, ispec,
-                                                                  params,
-                                                                  (*this)(ipatch), smpi,
-                                                                  RadiationTables,
-                                                                  MultiphotonBreitWheelerTables,
-                                                                  localDiags);
-            }
+            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  )
+                finalize_species( ipatch, ispec, params, smpi, RadiationTables, MultiphotonBreitWheelerTables, time_dual, itime );
         }
     }
 
@@ -323,18 +440,36 @@ void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime,
 {
     timers.maxwell.restart();
 
-    for (unsigned int ipassfilter=0 ; ipassfilter<params.currentFilter_passes ; ipassfilter++){
+    if ( params.currentFilter_single_exchange && params.currentFilter_passes > 0 ) {
+        // The ghost cells are at least as wide as the number of passes
         #pragma omp for schedule(static)
         for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
-            // Current spatial filtering
-            (*this)(ipatch)->EMfields->binomialCurrentFilter();
+            (*this)(ipatch)->EMfields->multipassBinomialCurrentFilter( params.currentFilter_passes );
+        }
+        // The corners of the ghost cells went through all the passes too : exchange one direction after the other
+        SyncVectorPatch::exchange_synchronized_per_direction( listJx_, (*this), smpi );
+        SyncVectorPatch::exchange_synchronized_per_direction( listJy_, (*this), smpi );
+        SyncVectorPatch::exchange_synchronized_per_direction( listJz_, (*this), smpi );
+    }
+    else {
+        for (unsigned int ipassfilter=0 ; ipassfilter<params.currentFilter_passes ; ipassfilter++){
+            #pragma omp for schedule(static)
+            for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+                // Current spatial filtering
+                (*this)(ipatch)->EMfields->binomialCurrentFilter();
+            }
+            SyncVectorPatch::exchangeJ( params, (*this), smpi );
+            SyncVectorPatch::finalizeexchangeJ( params, (*this) );
         }
-        SyncVectorPatch::exchangeJ( params, (*this), smpi );
-        SyncVectorPatch::finalizeexchangeJ( params, (*this) );
     }
 
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+        if ( (*this)(ipatch)->EMfields->MaxwellFusedSolver_ ) {
+            // Same as below, in a single sweep of the patch
+            (*(*this)(ipatch)->EMfields->MaxwellFusedSolver_)((*this)(ipatch)->EMfields);
+            continue;
+        }
         if (!params.is_spectral) {
             // Saving magnetic fields (to compute centered fields used in the particle pusher)
             // Stores B at time n in B_m.
@@ -493,8 +628,11 @@ void VectorPatch::runAllDiags(Params& params, SmileiMPI* smpi, unsigned int itim
         if( globalDiags[idiag]->theTimeIsNow ) {
             // All patches run
             #pragma omp for schedule(runtime)
-            for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
+            for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++) {
+                double t0 = MPI_Wtime();
                 globalDiags[idiag]->run( (*this)(ipatch), itime, simWindow );
+                (*this)(ipatch)->cost += MPI_Wtime() - t0;
+            }
             // MPI procs gather the data and compute
             #pragma omp single
             smpi->computeGlobalDiags( globalDiags[idiag], itime);
@@ -521,13 +659,20 @@ void VectorPatch::runAllDiags(Params& params, SmileiMPI* smpi, unsigned int itim
     }
     
     // Manage the "diag_flag" parameter, which indicates whether Rho and Js were used
+    // The currents and densities of species are released if the next timestep does not need them
     if( diag_flag ) {
         #pragma omp barrier
         #pragma omp single
-        diag_flag = false;
+        {
+            diag_flag = false;
+            releaseRhoJs_ = !needsRhoJsNow(itime+1);
+        }
         #pragma omp for
-        for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
+        for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++) {
+            if (releaseRhoJs_)
+                (*this)(ipatch)->EMfields->releaseRhoJs();
             (*this)(ipatch)->EMfields->restartRhoJs();
+        }
     }
     timers.diags.update();
 
@@ -1260,6 +1405,10 @@ void VectorPatch::load_balance(Params& params, double time_dual, SmileiMPI* smpi
     // Tell that the patches moved this iteration (needed for probes)
     lastIterationPatchesMoved = itime;
 
+    // Start a new window of cost measurement
+    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
+        (*this)(ipatch)->cost = 0.;
+
 }
 
 
@@ -1445,6 +1594,9 @@ void VectorPatch::output_exchanges(SmileiMPI* smpi)
 //! Resize vector of field*
 void VectorPatch::update_field_list( SmileiMPI* smpi )
 {
+    // Fields and patches changed, the aggregated messages will be rebuilt
+    clearAggregatedBuffers();
+
     int nDim = patches_[0]->EMfields->Ex_->dims_.size();
     densities.resize( 3*size() ) ; // Jx + Jy + Jz
 
@@ -1728,9 +1880,14 @@ void VectorPatch::applyCollisions(Params& params, int itime, Timers & timers)
     unsigned int ncoll = patches_[0]->vecCollisions.size();
 
     #pragma omp for schedule(static)
-    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
-        for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
+    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++) {
+        double t0 = MPI_Wtime();
+        for (unsigned int icoll=0 ; icoll<ncoll; icoll++) {
+            Rand::setStream( patches_[ipatch]->Hindex(), Rand::collisions_stream + icoll, itime );
             patches_[ipatch]->vecCollisions[icoll]->collide(params,patches_[ipatch],itime, localDiags);
+        }
+        patches_[ipatch]->cost += MPI_Wtime() - t0;
+    }
 
     #pragma omp single
     for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
@@ -1762,15 +1919,24 @@ void VectorPatch::saveExternalFields( Params &params )
 // Print information on the memory consumption
 void VectorPatch::check_memory_consumption(SmileiMPI* smpi)
 {
+    // Reserved memory (capacity of the particles structures) and memory used by the particles
     long int particlesMem(0);
+    uint64_t particlesUsedMem(0);
     for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
-        for (unsigned int ispec=0 ; ispec<patches_[ipatch]->vecSpecies.size(); ispec++)
-            particlesMem += patches_[ipatch]->vecSpecies[ispec]->getMemFootPrint();
-    MESSAGE( 1, "(Master) Species part = " << (int)( (double)particlesMem / 1024./1024.) << " MB" );
+        for (unsigned int ispec=0 ; ispec<patches_[ipatch]->vecSpecies.size(); ispec++) {
+            uint64_t used, reserved;
+            patches_[ipatch]->vecSpecies[ispec]->getParticlesMemory( used, reserved );
+            particlesMem     += reserved;
+            particlesUsedMem += used;
+        }
+    MESSAGE( 1, "(Master) Species part = " << (int)( (double)particlesMem / 1024./1024.) << " MB"
+             << " (used " << (int)( (double)particlesUsedMem / 1024./1024.) << " MB)" );
 
     long double dParticlesMem = (double)particlesMem / 1024./1024./1024.;
     MPI_Reduce( smpi->isMaster()?MPI_IN_PLACE:&dParticlesMem, &dParticlesMem, 1, MPI_LONG_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
-    MESSAGE( 1, setprecision(3) << "Global Species part = " << dParticlesMem << " GB" );
+    long double dParticlesUsedMem = (double)particlesUsedMem / 1024./1024./1024.;
+    MPI_Reduce( smpi->isMaster()?MPI_IN_PLACE:&dParticlesUsedMem, &dParticlesUsedMem, 1, MPI_LONG_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+    MESSAGE( 1, setprecision(3) << "Global Species part = " << dParticlesMem << " GB (used " << dParticlesUsedMem << " GB)" );
 
     MPI_Reduce( smpi->isMaster()?MPI_IN_PLACE:&particlesMem, &particlesMem, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD );
     MESSAGE( 1, "Max Species part = " << (int)( (double)particlesMem / 1024./1024.) << " MB" );
@@ -2,6 +2,7 @@
 #define VECTORPATCH_H
 
 #include <vector>
+#include <map>
 #include <iostream>
 #include <cstdlib>
 #include <iomanip>
@@ -24,6 +25,7 @@ class Field;
 class Timer;
 class SimWindow; 
 class DomainDecomposition;
+class AggregatedMPIbuffers;
 
 //! Class Patch : sub MPI domain
 //!     Collection of patch = MPI domain
@@ -244,9 +246,26 @@ public :
 
     // Keep track if we need the needsRhoJsNow
     int diag_flag;
+    //! Currents and densities of species released after the diags (not needed by the next timestep)
+    bool releaseRhoJs_;
+
+    //! Dynamics of one species in one patch, initiating the exchange of its particles
+    void dynamics_species(unsigned int ipatch, unsigned int ispec, Params& params, SmileiMPI* smpi, SimWindow* simWindow,
+                          RadiationTables & RadiationTables, MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
+                          double time_dual, int itime);
+    //! Import of the created particles, merging and sorting of one species in one patch
+    void finalize_species(unsigned int ipatch, unsigned int ispec, Params& params, SmileiMPI* smpi,
+                          RadiationTables & RadiationTables, MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
+                          double time_dual, int itime);
 
     int nrequests;
 
+    //! Ghost cells sent in a single message per neighbor MPI process (Main.aggregate_ghost_messages)
+    bool aggregate_ghost_messages_;
+    //! Aggregated messages of the synchronization of fields along dims (found by the names of the components of fields
+    //! and by kind), NULL if the messages are not aggregated. Must be called by all the threads.
+    AggregatedMPIbuffers* aggregatedBuffers( std::vector<Field*>& fields, std::vector<unsigned int>& dims, int kind );
+
     //! Tells which iteration was last time the patches moved (by moving window or load balancing)
     unsigned int lastIterationPatchesMoved;
 
@@ -289,6 +308,11 @@ private :
     double antenna_intensity;
 
     std::vector<Timer*> diag_timers;
+
+    //! Aggregated messages, by synchronization (AggregatedMPIbuffers::phase) : same keys on all MPI processes
+    std::map< std::string, AggregatedMPIbuffers* > aggregated_buffers_;
+    //! Delete them, and unmap the field arenas of the other MPI processes of the node that they read
+    void clearAggregatedBuffers();
     
 };
 
@@ -2,8 +2,19 @@
 
 #include "Params.h"
 #include "Patch.h"
+#include "Tools.h"
 
 Projector::Projector(Params &params, Patch* patch)
 {
 }
 
+void Projector::project_chunk(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nchunk, int* iold, double* delta, double* invgf, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+{
+    ERROR("Fused dynamics not available for this projector");
+}
+
+void Projector::project_tiles(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+{
+    ERROR("Tiled projection not available for this projector");
+}
+
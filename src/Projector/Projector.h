@@ -32,6 +32,12 @@ public:
 
    //!Wrapper
     virtual void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, bool is_spectral, std::vector<unsigned int> &b_dim, int ispec) = 0;
+
+    //! Project a chunk of particles, iold/delta/invgf stored in buffers of size nchunk (fused dynamics)
+    virtual void project_chunk(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nchunk, int* iold, double* delta, double* invgf, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec);
+
+    //! Project particles [istart,iend[ through local tiles, vectorized over particles (tiled_projection)
+    virtual void project_tiles(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec);
 private:
 
 };
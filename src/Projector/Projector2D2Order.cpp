@@ -45,9 +45,8 @@ Projector2D2Order::~Projector2D2Order()
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project current densities : main projector
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold, int nparts)
 {
-    int nparts = particles.size();
     
     // -------------------------------------
     // Variable declaration & initialization
@@ -174,9 +173,8 @@ void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, Particle
 // ---------------------------------------------------------------------------------------------------------------------
 //!  Project current densities & charge : diagFields timstep
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector2D2Order::operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold, int nparts)
 {
-    int nparts = particles.size();
     
     // -------------------------------------
     // Variable declaration & initialization
@@ -478,6 +476,7 @@ void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
+    int nparts = particles.size();
     
     int dim1 = EMfields->dimPrim[1];
     
@@ -488,7 +487,7 @@ void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
             double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1));
             double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw*dim1);
             for (int ipart=istart ; ipart<iend; ipart++ )
-                (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+                (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart], nparts);
         }
         else {
             double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw* dim1   );
@@ -496,7 +495,7 @@ void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
             double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw* dim1   );
             double* b_rho=  &(*EMfields->rho_)(ibin*clrw* dim1   );
             for ( int ipart=istart ; ipart<iend; ipart++ )
-                (*this)(b_Jx , b_Jy , b_Jz , b_rho , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+                (*this)(b_Jx , b_Jy , b_Jz , b_rho , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart], nparts);
         }         
     // Otherwise, the projection may apply to the species-specific arrays
     } else {
@@ -505,6 +504,30 @@ void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
         double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw* dim1   ) : &(*EMfields->Jz_ )(ibin*clrw* dim1   ) ;
         double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   ) : &(*EMfields->rho_)(ibin*clrw* dim1   ) ;
         for (int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart], nparts);
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project a chunk of particles of bin ibin (fused dynamics), iold/delta/invgf indexed from istart with stride nchunk
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D2Order::project_chunk(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nchunk, int* iold, double* delta, double* invgf, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+{
+    int dim1 = EMfields->dimPrim[1];
+
+    if (!diag_flag){
+        double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw*dim1);
+        double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1));
+        double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw*dim1);
+        for (int ipart=istart ; ipart<iend; ipart++ )
+            (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, invgf[ipart-istart], ibin*clrw, b_dim, &iold[ipart-istart], &delta[ipart-istart], nchunk);
+    } else {
+        double* b_Jx  = EMfields->Jx_s [ispec] ? &(*EMfields->Jx_s [ispec])(ibin*clrw* dim1   ) : &(*EMfields->Jx_ )(ibin*clrw* dim1   ) ;
+        double* b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw*(dim1+1)) : &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)) ;
+        double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw* dim1   ) : &(*EMfields->Jz_ )(ibin*clrw* dim1   ) ;
+        double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   ) : &(*EMfields->rho_)(ibin*clrw* dim1   ) ;
+        for (int ipart=istart ; ipart<iend; ipart++ )
+            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, invgf[ipart-istart], ibin*clrw, b_dim, &iold[ipart-istart], &delta[ipart-istart], nchunk);
     }
 }
@@ -49,9 +49,8 @@ Projector3D2Order::~Projector3D2Order()
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local currents (sort)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold, int nparts)
 {
-    int nparts = particles.size();
 
     // -------------------------------------
     // Variable declaration & initialization
@@ -328,9 +327,8 @@ void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, Particle
 // ---------------------------------------------------------------------------------------------------------------------
 //! Project local current densities (sort)
 // ---------------------------------------------------------------------------------------------------------------------
-void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold)
+void Projector3D2Order::operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold, int nparts)
 {
-    int nparts = particles.size();
 
     // -------------------------------------
     // Variable declaration & initialization
@@ -716,6 +714,7 @@ void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
     std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
     std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
     std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
+    int nparts = particles.size();
     
     int dim1 = EMfields->dimPrim[1];
     int dim2 = EMfields->dimPrim[2];
@@ -727,7 +726,7 @@ void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
             double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)* dim2   );
             double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw* dim1   *(dim2+1));
             for ( int ipart=istart ; ipart<iend; ipart++ )
-                (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+                (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart], nparts);
         }
         else {
             double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw* dim1   * dim2   );
@@ -735,7 +734,7 @@ void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
             double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw* dim1   *(dim2+1));
             double* b_rho=  &(*EMfields->rho_)(ibin*clrw* dim1   * dim2   );
             for ( int ipart=istart ; ipart<iend; ipart++ )
-                (*this)(b_Jx , b_Jy , b_Jz , b_rho , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+                (*this)(b_Jx , b_Jy , b_Jz , b_rho , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart], nparts);
         }
     // Otherwise, the projection may apply to the species-specific arrays
     } else {
@@ -744,7 +743,256 @@ void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
         double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw*dim1*(dim2+1)) : &(*EMfields->Jz_ )(ibin*clrw*dim1*(dim2+1)) ;
         double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->rho_)(ibin*clrw* dim1   *dim2) ;
         for ( int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart]);
+            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[ipart], &(*delta)[ipart], nparts);
+    }
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project a chunk of particles of bin ibin (fused dynamics), iold/delta/invgf indexed from istart with stride nchunk
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D2Order::project_chunk(ElectroMagn* EMfields, Particles &particles, int istart, int iend, int nchunk, int* iold, double* delta, double* invgf, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+{
+    int dim1 = EMfields->dimPrim[1];
+    int dim2 = EMfields->dimPrim[2];
+
+    if (!diag_flag){
+        double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw* dim1   * dim2   );
+        double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)* dim2   );
+        double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw* dim1   *(dim2+1));
+        for ( int ipart=istart ; ipart<iend; ipart++ )
+            (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, invgf[ipart-istart], ibin*clrw, b_dim, &iold[ipart-istart], &delta[ipart-istart], nchunk);
+    } else {
+        double* b_Jx  = EMfields->Jx_s [ispec] ? &(*EMfields->Jx_s [ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->Jx_ )(ibin*clrw* dim1   *dim2) ;
+        double* b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw*(dim1+1)*dim2) : &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)*dim2) ;
+        double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw*dim1*(dim2+1)) : &(*EMfields->Jz_ )(ibin*clrw*dim1*(dim2+1)) ;
+        double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->rho_)(ibin*clrw* dim1   *dim2) ;
+        for ( int ipart=istart ; ipart<iend; ipart++ )
+            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, invgf[ipart-istart], ibin*clrw, b_dim, &iold[ipart-istart], &delta[ipart-istart], nchunk);
+    }
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project particles [istart,iend[ through local tiles (tiled_projection)
+//!   Consecutive particles which share their former cell (long runs once particles are sorted by cell) are deposited
+//!   by packs of tile_pack particles, one per SIMD lane, in 5x5x5 lane-wise tiles. At the end of each run, the lanes are
+//!   summed and the tiles are added once to the current densities of the patch.
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D2Order::project_tiles(ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
+{
+    int*    iold     = smpi->dynamics_iold[ithread].data();
+    double* deltaold = smpi->dynamics_deltaold[ithread].data();
+    int nparts = particles.size();
+
+    int dim1 = EMfields->dimPrim[1];
+    int dim2 = EMfields->dimPrim[2];
+
+    double *b_Jx, *b_Jy, *b_Jz, *b_rho(NULL);
+    if (!diag_flag){
+        b_Jx =  &(*EMfields->Jx_ )(ibin*clrw* dim1   * dim2   );
+        b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)* dim2   );
+        b_Jz =  &(*EMfields->Jz_ )(ibin*clrw* dim1   *(dim2+1));
+    } else {
+        b_Jx  = EMfields->Jx_s [ispec] ? &(*EMfields->Jx_s [ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->Jx_ )(ibin*clrw* dim1   *dim2) ;
+        b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw*(dim1+1)*dim2) : &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)*dim2) ;
+        b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw*dim1*(dim2+1)) : &(*EMfields->Jz_ )(ibin*clrw*dim1*(dim2+1)) ;
+        b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->rho_)(ibin*clrw* dim1   *dim2) ;
+    }
+
+    double* position_x = &( particles.position(0,0) );
+    double* position_y = &( particles.position(1,0) );
+    double* position_z = &( particles.position(2,0) );
+    double* weight     = &( particles.weight(0) );
+    short*  charge     = &( particles.charge(0) );
+
+    const int np_max = tile_pack;
+    // Lane-wise tiles, index ((i*5+j)*5+k)*tile_pack + lane
+    double tileJx[125*np_max], tileJy[125*np_max], tileJz[125*np_max], tileRho[125*np_max];
+    // Esirkepov coefficients of the pack, index m*tile_pack + lane
+    double Sx0[5*np_max], Sy0[5*np_max], Sz0[5*np_max], Sx1[5*np_max], Sy1[5*np_max], Sz1[5*np_max];
+    double DSx[5*np_max], DSy[5*np_max], DSz[5*np_max];
+    double charge_weight[np_max];
+
+    int ipart = istart;
+    while (ipart < iend) {
+
+        // Run of particles sharing the former cell of ipart
+        int ipo = iold[ipart], jpo = iold[ipart+nparts], kpo = iold[ipart+2*nparts];
+        int irun_end = ipart+1;
+        while ( irun_end<iend && iold[irun_end]==ipo && iold[irun_end+nparts]==jpo && iold[irun_end+2*nparts]==kpo )
+            irun_end++;
+
+        for (int i=0 ; i<125*np_max ; i++) {
+            tileJx[i] = 0.;
+            tileJy[i] = 0.;
+            tileJz[i] = 0.;
+        }
+        if (diag_flag)
+            for (int i=0 ; i<125*np_max ; i++)
+                tileRho[i] = 0.;
+
+        for (int ipack=ipart ; ipack<irun_end ; ipack+=np_max) {
+            int np = min(np_max, irun_end-ipack);
+
+            // Esirkepov coefficients S0, S1 and DS of the particles of the pack
+            #pragma omp simd
+            for (int p=0 ; p<np ; p++) {
+                int ip_ = ipack+p;
+                charge_weight[p] = (double)(charge[ip_])*weight[ip_];
+
+                double delta, delta2;
+                delta  = deltaold[ip_];
+                delta2 = delta*delta;
+                Sx0[0*np_max+p] = 0.;
+                Sx0[1*np_max+p] = 0.5 * (delta2-delta+0.25);
+                Sx0[2*np_max+p] = 0.75-delta2;
+                Sx0[3*np_max+p] = 0.5 * (delta2+delta+0.25);
+                Sx0[4*np_max+p] = 0.;
+                delta  = deltaold[ip_+nparts];
+                delta2 = delta*delta;
+                Sy0[0*np_max+p] = 0.;
+                Sy0[1*np_max+p] = 0.5 * (delta2-delta+0.25);
+                Sy0[2*np_max+p] = 0.75-delta2;
+                Sy0[3*np_max+p] = 0.5 * (delta2+delta+0.25);
+                Sy0[4*np_max+p] = 0.;
+                delta  = deltaold[ip_+2*nparts];
+                delta2 = delta*delta;
+                Sz0[0*np_max+p] = 0.;
+                Sz0[1*np_max+p] = 0.5 * (delta2-delta+0.25);
+                Sz0[2*np_max+p] = 0.75-delta2;
+                Sz0[3*np_max+p] = 0.5 * (delta2+delta+0.25);
+                Sz0[4*np_max+p] = 0.;
+
+                // S1 is shifted by the displacement of the particle (-1, 0 or +1 cell) inside the 5 points stencil
+                double xpn = position_x[ip_] * dx_inv_;
+                int ip = Tools::round_index(xpn);
+                int ip_m_ipo = ip-ipo-i_domain_begin;
+                delta  = xpn - (double)ip;
+                delta2 = delta*delta;
+                for (int m=0 ; m<5 ; m++) {
+                    int d = m-2-ip_m_ipo;
+                    Sx1[m*np_max+p] = (d==-1) * 0.5 * (delta2-delta+0.25) + (d==0) * (0.75-delta2) + (d==1) * 0.5 * (delta2+delta+0.25);
+                    DSx[m*np_max+p] = Sx1[m*np_max+p] - Sx0[m*np_max+p];
+                }
+                double ypn = position_y[ip_] * dy_inv_;
+                int jp = Tools::round_index(ypn);
+                int jp_m_jpo = jp-jpo-j_domain_begin;
+                delta  = ypn - (double)jp;
+                delta2 = delta*delta;
+                for (int m=0 ; m<5 ; m++) {
+                    int d = m-2-jp_m_jpo;
+                    Sy1[m*np_max+p] = (d==-1) * 0.5 * (delta2-delta+0.25) + (d==0) * (0.75-delta2) + (d==1) * 0.5 * (delta2+delta+0.25);
+                    DSy[m*np_max+p] = Sy1[m*np_max+p] - Sy0[m*np_max+p];
+                }
+                double zpn = position_z[ip_] * dz_inv_;
+                int kp = Tools::round_index(zpn);
+                int kp_m_kpo = kp-kpo-k_domain_begin;
+                delta  = zpn - (double)kp;
+                delta2 = delta*delta;
+                for (int m=0 ; m<5 ; m++) {
+                    int d = m-2-kp_m_kpo;
+                    Sz1[m*np_max+p] = (d==-1) * 0.5 * (delta2-delta+0.25) + (d==0) * (0.75-delta2) + (d==1) * 0.5 * (delta2+delta+0.25);
+                    DSz[m*np_max+p] = Sz1[m*np_max+p] - Sz0[m*np_max+p];
+                }
+            }
+
+            // Jx^(d,p,p)
+            for (int j=0 ; j<5 ; j++) {
+                for (int k=0 ; k<5 ; k++) {
+                    #pragma omp simd
+                    for (int p=0 ; p<np ; p++) {
+                        double crx_p = charge_weight[p]*dx_ov_dt;
+                        double sy0 = Sy0[j*np_max+p], dsy = DSy[j*np_max+p];
+                        double sz0 = Sz0[k*np_max+p], dsz = DSz[k*np_max+p];
+                        double w   = crx_p * (sy0*sz0 + 0.5*dsy*sz0 + 0.5*dsz*sy0 + one_third*dsy*dsz);
+                        double tmp = 0.;
+                        for (int i=1 ; i<5 ; i++) {
+                            tmp -= DSx[(i-1)*np_max+p] * w;
+                            tileJx[((i*5+j)*5+k)*np_max+p] += tmp;
+                        }
+                    }
+                }
+            }
+            // Jy^(p,d,p)
+            for (int i=0 ; i<5 ; i++) {
+                for (int k=0 ; k<5 ; k++) {
+                    #pragma omp simd
+                    for (int p=0 ; p<np ; p++) {
+                        double cry_p = charge_weight[p]*dy_ov_dt;
+                        double sx0 = Sx0[i*np_max+p], dsx = DSx[i*np_max+p];
+                        double sz0 = Sz0[k*np_max+p], dsz = DSz[k*np_max+p];
+                        double w   = cry_p * (sz0*sx0 + 0.5*dsz*sx0 + 0.5*dsx*sz0 + one_third*dsz*dsx);
+                        double tmp = 0.;
+                        for (int j=1 ; j<5 ; j++) {
+                            tmp -= DSy[(j-1)*np_max+p] * w;
+                            tileJy[((i*5+j)*5+k)*np_max+p] += tmp;
+                        }
+                    }
+                }
+            }
+            // Jz^(p,p,d)
+            for (int i=0 ; i<5 ; i++) {
+                for (int j=0 ; j<5 ; j++) {
+                    #pragma omp simd
+                    for (int p=0 ; p<np ; p++) {
+                        double crz_p = charge_weight[p]*dz_ov_dt;
+                        double sx0 = Sx0[i*np_max+p], dsx = DSx[i*np_max+p];
+                        double sy0 = Sy0[j*np_max+p], dsy = DSy[j*np_max+p];
+                        double w   = crz_p * (sx0*sy0 + 0.5*dsx*sy0 + 0.5*dsy*sx0 + one_third*dsx*dsy);
+                        double tmp = 0.;
+                        for (int k=1 ; k<5 ; k++) {
+                            tmp -= DSz[(k-1)*np_max+p] * w;
+                            tileJz[((i*5+j)*5+k)*np_max+p] += tmp;
+                        }
+                    }
+                }
+            }
+            // Rho^(p,p,p)
+            if (diag_flag) {
+                for (int i=0 ; i<5 ; i++) {
+                    for (int j=0 ; j<5 ; j++) {
+                        for (int k=0 ; k<5 ; k++) {
+                            #pragma omp simd
+                            for (int p=0 ; p<np ; p++) {
+                                tileRho[((i*5+j)*5+k)*np_max+p] += charge_weight[p] * Sx1[i*np_max+p]*Sy1[j*np_max+p]*Sz1[k*np_max+p];
+                            }
+                        }
+                    }
+                }
+            }
+        }// ipack
+
+        // Reduction of the lanes, added once to the current densities of the patch
+        int iloc0 = ipo - ibin*clrw - 2; // i/j/kpo stored with - i/j/k_domain_begin in Interpolator
+        int jloc0 = jpo - 2;
+        int kloc0 = kpo - 2;
+        for (int i=0 ; i<5 ; i++) {
+            for (int j=0 ; j<5 ; j++) {
+                for (int k=0 ; k<5 ; k++) {
+                    int itile = ((i*5+j)*5+k)*np_max;
+                    double jx(0.), jy(0.), jz(0.);
+                    for (int p=0 ; p<np_max ; p++) {
+                        jx += tileJx[itile+p];
+                        jy += tileJy[itile+p];
+                        jz += tileJz[itile+p];
+                    }
+                    b_Jx[ (iloc0+i)*b_dim[2]*b_dim[1]     + (jloc0+j)*b_dim[2]     + kloc0+k ] += jx;
+                    b_Jy[ (iloc0+i)*b_dim[2]*(b_dim[1]+1) + (jloc0+j)*b_dim[2]     + kloc0+k ] += jy;
+                    b_Jz[ (iloc0+i)*(b_dim[2]+1)*b_dim[1] + (jloc0+j)*(b_dim[2]+1) + kloc0+k ] += jz;
+                    if (diag_flag) {
+                        double rho(0.);
+                        for (int p=0 ; p<np_max ; p++)
+                            rho += tileRho[itile+p];
+                        b_rho[ (iloc0+i)*b_dim[2]*b_dim[1] + (jloc0+j)*b_dim[2] + kloc0+k ] += rho;
+                    }
+                }
+            }
+        }
+
+        ipart = irun_end;
     }
 
 }
@@ -179,6 +179,14 @@ class Main(SmileiSingleton):
     patch_orientation = ""
     clrw = -1
     every_clean_particles_overhead = 100
+    particles_capacity_watermarks = [2., 1.25]
+    particles_capacity_decay = 0.5
+    direct_particle_exchange = False
+    aggregate_ghost_messages = False
+    shared_memory_exchanges = False
+    fused_field_step = False
+    field_arena = False
+    field_arena_huge_pages = False
     timestep = None
     nmodes = 2
     timestep_over_CFL = None
@@ -294,6 +302,7 @@ class LoadBalancing(SmileiSingleton):
     initial_balance = True
     cell_load = 1.0
     frozen_particle_load = 0.1
+    measured_cost = False
 
 
 class MovingWindow(SmileiSingleton):
@@ -314,12 +323,14 @@ class Checkpoints(SmileiSingleton):
     dump_deflate = 0
     exit_after_dump = True
     file_grouping = None
+    differential = False
     restart_files = []
 
 class CurrentFilter(SmileiSingleton):
     """Current filtering parameters"""
     model = "binomial"
     passes = 0
+    single_exchange = False
 
 class FieldFilter(SmileiSingleton):
     """Fields filtering parameters"""
@@ -349,6 +360,14 @@ class Species(SmileiComponent):
     multiphoton_Breit_Wheeler = [None,None]
     multiphoton_Breit_Wheeler_sampling = [1,1]
     time_frozen = 0.0
+    cell_sort_every = 0
+    fused_dynamics = False
+    tiled_projection = False
+    merging_method = "none"
+    merge_every = 0
+    merge_min_particles_per_cell = 16
+    merge_packet_size = 4
+    merge_momentum_cell_size = [16,16,16]
     radiating = False
     relativistic_field_initialization = False
     time_relativistic_initialization = 0.0
@@ -160,21 +160,9 @@ void RadiationNiel::operator() (
         }
     }*/
 
-    // Vectorized computation of the random number in a uniform distribution
-    #pragma omp simd
-    for (ipart=0 ; ipart < nbparticles; ipart++ )
-    {
-
-        // Below chipa = chipa_radiation_threshold, radiation losses are negligible
-        if (chipa[ipart] > chipa_radiation_threshold)
-        {
-
-          // Pick a random number in the normal distribution of standard
-          // deviation sqrt(dt) (variance dt)
-          //random_numbers[ipart] = 2.*Rand::uniform() -1.;
-          random_numbers[ipart] = 2.*drand48() -1.;
-        }
-    }
+    // Vectorized computation of the random number in a uniform distribution ]-1,1[
+    // from the counter-based stream of the patch
+    Rand::uniform2( random_numbers, nbparticles );
 
     // Vectorized computation of the random number in a normal distribution
     double p;
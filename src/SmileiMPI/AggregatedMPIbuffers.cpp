@@ -0,0 +1,351 @@
+#include "AggregatedMPIbuffers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <map>
+
+#include "Field.h"
+#include "FieldArena.h"
+#include "ElectroMagn.h"
+#include "Patch.h"
+#include "VectorPatch.h"
+#include "SmileiMPI.h"
+#include "Tools.h"
+
+using namespace std;
+
+AggregatedMPIbuffers::AggregatedMPIbuffers()
+{
+    kind_ = -1;
+    comm_ = MPI_COMM_NULL;
+    tag_  = 0;
+    node_comm_ = MPI_COMM_NULL;
+}
+
+
+AggregatedMPIbuffers::~AggregatedMPIbuffers()
+{
+}
+
+
+string AggregatedMPIbuffers::phase( vector<Field*>& fields, vector<unsigned int>& dims, int kind, unsigned int nPatches )
+{
+    string name;
+    for (unsigned int ifield=0 ; ifield<fields.size() ; ifield+=nPatches)
+        name += fields[ifield]->name + " ";
+    name += (char)('0'+kind);
+    for (unsigned int i=0 ; i<dims.size() ; i++)
+        name += (char)('0'+dims[i]);
+    return name;
+}
+
+
+// Ordering of the blocks in the message of a neighbor MPI process, identical for the sender and the receiver
+bool AggregatedMPIbuffers::before( const Block& a, const Block& b )
+{
+    if (a.rank   != b.rank  ) return a.rank   < b.rank;
+    if (a.iDim   != b.iDim  ) return a.iDim   < b.iDim;
+    if (a.comp   != b.comp  ) return a.comp   < b.comp;
+    if (a.hindex != b.hindex) return a.hindex < b.hindex;
+    return a.side < b.side;
+}
+
+
+// Number of doubles of a block : slab of width cells along iDim, all cells along the other directions
+unsigned int AggregatedMPIbuffers::blockSize( const Block& block )
+{
+    unsigned int size = block.width;
+    for (unsigned int i=0 ; i<block.field->dims_.size() ; i++)
+        if (i != block.iDim)
+            size *= block.field->dims_[i];
+    return size;
+}
+
+
+// The slab is made of outer contiguous chunks of width*inner doubles. The arrays in and out have in_n and out_n cells
+// along iDim, and the slab starts at their cells in_start and out_start
+void AggregatedMPIbuffers::copy( const Block& block, const double* in, unsigned int in_n, unsigned int in_start,
+                                 double* out, unsigned int out_n, unsigned int out_start )
+{
+    const vector<unsigned int>& dims = block.field->dims_;
+    unsigned int outer(1), inner(1);
+    for (unsigned int i=0 ; i<block.iDim ; i++)
+        outer *= dims[i];
+    for (unsigned int i=block.iDim+1 ; i<dims.size() ; i++)
+        inner *= dims[i];
+    unsigned int chunk = block.width*inner;
+    for (unsigned int o=0 ; o<outer ; o++)
+        memcpy( out + (o*out_n + out_start)*inner, in + (o*in_n + in_start)*inner, chunk*sizeof(double) );
+}
+
+
+void AggregatedMPIbuffers::pack( const Block& block, double* out )
+{
+    copy( block, block.field->data_, block.field->dims_[block.iDim], block.start, out, block.width, 0 );
+}
+
+
+void AggregatedMPIbuffers::unpack( const Block& block, const double* in )
+{
+    // Sum : the layout of Field::MPIbuff.buf is the one of the block
+    if (block.buf) {
+        memcpy( block.buf, in, blockSize(block)*sizeof(double) );
+        return;
+    }
+    copy( block, in, block.width, 0, block.field->data_, block.field->dims_[block.iDim], block.start );
+}
+
+
+// The sending field has the dimensions of the receiving one
+void AggregatedMPIbuffers::copyShared( const Block& block )
+{
+    unsigned int n = block.field->dims_[block.iDim];
+    if (block.buf)
+        copy( block, block.remote, n, block.remote_start, block.buf, block.width, 0 );
+    else
+        copy( block, block.remote, n, block.remote_start, block.field->data_, n, block.start );
+}
+
+
+// Start of the block sent on side iNeighbor of a field with n cells along the direction
+static unsigned int sendStart( int kind, int iNeighbor, unsigned int n, unsigned int os, unsigned int isDual )
+{
+    if (kind==AggregatedMPIbuffers::exchange)
+        return iNeighbor * ( n - (2*os+1+isDual) ) + (1-iNeighbor) * ( os+1+isDual );
+    else
+        return iNeighbor * ( n - (2*os+1+isDual) );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Rebuild the list of blocks if the patches, their neighbors or the fields changed
+// Done by a single thread
+// ---------------------------------------------------------------------------------------------------------------------
+bool AggregatedMPIbuffers::update( vector<Field*>& fields, vector<unsigned int>& dims, int kind, VectorPatch& vecPatches, SmileiMPI* smpi )
+{
+    unsigned int nPatches = vecPatches.size();
+    unsigned int nComp = fields.size()/nPatches;
+
+    vector<double*> data( fields.size() );
+    for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++)
+        data[ifield] = fields[ifield]->data_;
+    vector<unsigned int> env( 2*nPatches );
+    for (unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++) {
+        env[2*ipatch  ] = vecPatches(ipatch)->hindex;
+        env[2*ipatch+1] = vecPatches(ipatch)->MPIenv_version_;
+    }
+    if ( (kind==kind_) && (dims==dims_) && (fields==fields_) && (data==data_) && (env==env_) )
+        return false;
+    kind_   = kind;
+    dims_   = dims;
+    fields_ = fields;
+    data_   = data;
+    env_  = env;
+
+    // Same tag on all MPI processes for a given synchronization
+    tag_ = std::hash<string>()( phase( fields, dims, kind, nPatches ) ) % 32768;
+
+    bool shared_memory = ( smpi->getNodeComm() != MPI_COMM_NULL );
+
+    send_blocks_.clear();
+    recv_blocks_.clear();
+    shared_blocks_.clear();
+    for (unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++) {
+        Patch* patch = vecPatches(ipatch);
+        for (unsigned int icomp=0 ; icomp<nComp ; icomp++) {
+            Field* field = fields[icomp*nPatches+ipatch];
+            if ( (kind==sum) && (field->MPIbuff.buf[0][0].size()==0) )
+                field->MPIbuff.allocate(field->dims_.size(), field, patch->oversize);
+            for (unsigned int id=0 ; id<dims.size() ; id++) {
+                unsigned int iDim = dims[id];
+                unsigned int n       = field->dims_[iDim];
+                unsigned int os      = patch->oversize[iDim];
+                unsigned int isDual  = field->isDual_[iDim];
+                for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+                    if ( !patch->is_a_MPI_neighbor( iDim, iNeighbor ) )
+                        continue;
+                    Block block;
+                    block.field = field;
+                    block.iDim  = iDim;
+                    block.comp  = icomp;
+                    block.rank  = patch->MPI_neighbor_[iDim][iNeighbor];
+                    block.width = (kind==exchange) ? os : 2*os+1+isDual;
+                    block.remote = NULL;
+
+                    // Fields in the shared arenas of the same node : read by the receiver, not sent
+                    bool shared = shared_memory && field->in_arena_ && ( smpi->nodeRank( block.rank ) >= 0 );
+
+                    // Sent by this patch on its side iNeighbor
+                    block.hindex = patch->hindex;
+                    block.side   = iNeighbor;
+                    block.buf    = NULL;
+                    block.start  = sendStart( kind, iNeighbor, n, os, isDual );
+                    if (!shared)
+                        send_blocks_.push_back( block );
+
+                    // Sent by the neighbor on its opposite side
+                    block.hindex = patch->neighbor_[iDim][iNeighbor];
+                    block.side   = 1-iNeighbor;
+                    if (kind==exchange)
+                        block.start = iNeighbor * ( n - os );
+                    else
+                        block.buf = &(field->MPIbuff.buf[iDim][iNeighbor][0]);
+                    if (shared) {
+                        block.arena_offset = patch->EMfields->arena().offset( field->data_ );
+                        block.remote_start = sendStart( kind, 1-iNeighbor, n, os, isDual );
+                        shared_blocks_.push_back( block );
+                    }
+                    else
+                        recv_blocks_.push_back( block );
+                }
+            }
+        }
+    }
+
+    order( send_blocks_, send_ranks_, send_displs_ );
+    order( recv_blocks_, recv_ranks_, recv_displs_ );
+    send_buffer_.resize( send_displs_.back() );
+    recv_buffer_.resize( recv_displs_.back() );
+    requests_.resize( send_ranks_.size() + recv_ranks_.size() );
+    return true;
+}
+
+
+void AggregatedMPIbuffers::order( vector<Block>& blocks, vector<int>& ranks, vector<unsigned int>& displs )
+{
+    sort( blocks.begin(), blocks.end(), before );
+    ranks.clear();
+    displs.assign( 1, 0 );
+    unsigned int offset = 0;
+    for (unsigned int ib=0 ; ib<blocks.size() ; ib++) {
+        if ( ranks.empty() || (blocks[ib].rank != ranks.back()) ) {
+            if (!ranks.empty())
+                displs.push_back( offset );
+            ranks.push_back( blocks[ib].rank );
+        }
+        blocks[ib].message = ranks.size()-1;
+        blocks[ib].offset  = offset;
+        offset += blockSize( blocks[ib] );
+    }
+    if (!ranks.empty())
+        displs.push_back( offset );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Pack the sent blocks (threads share the blocks) and post the messages, one per neighbor MPI process
+// With shared memory, copy the blocks of the node between two synchronizations of the node : the fields are complete
+// before the first one, and their owners modify them only after the second one
+// ---------------------------------------------------------------------------------------------------------------------
+void AggregatedMPIbuffers::init( vector<Field*>& fields, vector<unsigned int>& dims, int kind, VectorPatch& vecPatches, SmileiMPI* smpi )
+{
+    #pragma omp single
+    {
+        bool changed = update( fields, dims, kind, vecPatches, smpi );
+        comm_      = smpi->getGhostComm();
+        node_comm_ = smpi->getNodeComm();
+        if ( node_comm_ != MPI_COMM_NULL ) {
+            // The arenas are looked up again as soon as the plan of one of the MPI processes of the node changed
+            int rebuild = changed;
+            MPI_Allreduce( MPI_IN_PLACE, &rebuild, 1, MPI_INT, MPI_LOR, node_comm_ );
+            if (rebuild)
+                attachArenas( vecPatches, smpi );
+        }
+    }
+
+    #pragma omp for schedule(static)
+    for (unsigned int ib=0 ; ib<send_blocks_.size() ; ib++)
+        pack( send_blocks_[ib], &send_buffer_[send_blocks_[ib].offset] );
+
+    #pragma omp single
+    {
+        for (unsigned int ir=0 ; ir<recv_ranks_.size() ; ir++)
+            MPI_Irecv( &recv_buffer_[recv_displs_[ir]], recv_displs_[ir+1]-recv_displs_[ir], MPI_DOUBLE,
+                       recv_ranks_[ir], tag_, comm_, &requests_[ir] );
+        for (unsigned int ir=0 ; ir<send_ranks_.size() ; ir++)
+            MPI_Isend( &send_buffer_[send_displs_[ir]], send_displs_[ir+1]-send_displs_[ir], MPI_DOUBLE,
+                       send_ranks_[ir], tag_, comm_, &requests_[recv_ranks_.size()+ir] );
+        if ( node_comm_ != MPI_COMM_NULL )
+            nodeBarrier();
+    }
+
+    if ( node_comm_ != MPI_COMM_NULL ) {
+        #pragma omp for schedule(static)
+        for (unsigned int ib=0 ; ib<shared_blocks_.size() ; ib++)
+            copyShared( shared_blocks_[ib] );
+        #pragma omp single
+        nodeBarrier();
+    }
+}
+
+
+void AggregatedMPIbuffers::finalize()
+{
+    #pragma omp single
+    {
+        if ( requests_.size() )
+            MPI_Waitall( requests_.size(), &requests_[0], MPI_STATUSES_IGNORE );
+    }
+
+    #pragma omp for schedule(static)
+    for (unsigned int ib=0 ; ib<recv_blocks_.size() ; ib++) {
+        const Block& block = recv_blocks_[ib];
+        unpack( block, &recv_buffer_[block.offset] );
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Find the data of the sending fields of the shared blocks
+// Collective on the node, done by a single thread
+// ---------------------------------------------------------------------------------------------------------------------
+void AggregatedMPIbuffers::attachArenas( VectorPatch& vecPatches, SmileiMPI* smpi )
+{
+    // Directory : number of patches, then hindex and serial of the arena of each patch
+    unsigned int nPatches = vecPatches.size();
+    MPI_Win window;
+    unsigned int* directory;
+    MPI_Win_allocate_shared( (1+2*nPatches)*sizeof(unsigned int), sizeof(unsigned int), MPI_INFO_NULL, node_comm_, &directory, &window );
+    MPI_Win_lock_all( MPI_MODE_NOCHECK, window );
+    directory[0] = nPatches;
+    for (unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++) {
+        directory[1+2*ipatch] = vecPatches(ipatch)->hindex;
+        directory[2+2*ipatch] = vecPatches(ipatch)->EMfields->arena().serial();
+    }
+    MPI_Win_sync( window );
+    MPI_Barrier( node_comm_ );
+    MPI_Win_sync( window );
+
+    // Serial of the arena of each patch of the neighbor MPI processes of the node
+    map< int, map<unsigned int, unsigned int> > serials;
+    for (unsigned int ib=0 ; ib<shared_blocks_.size() ; ib++) {
+        Block& block = shared_blocks_[ib];
+        map<unsigned int, unsigned int>& serial = serials[block.rank];
+        if ( serial.empty() ) {
+            MPI_Aint size;
+            int disp_unit;
+            unsigned int* remote;
+            MPI_Win_shared_query( window, smpi->nodeRank( block.rank ), &size, &disp_unit, &remote );
+            for (unsigned int ipatch=0 ; ipatch<remote[0] ; ipatch++)
+                serial[ remote[1+2*ipatch] ] = remote[2+2*ipatch];
+        }
+        if ( serial.count( block.hindex ) == 0 )
+            ERROR( "Patch " << block.hindex << " not found on MPI process " << block.rank );
+        const char* arena = FieldArena::attach( block.rank, serial[block.hindex] );
+        block.remote = reinterpret_cast<const double*>( arena + block.arena_offset );
+    }
+
+    // Freed once all the MPI processes of the node have read the directories
+    MPI_Win_unlock_all( window );
+    MPI_Win_free( &window );
+}
+
+
+void AggregatedMPIbuffers::nodeBarrier()
+{
+    atomic_thread_fence( memory_order_seq_cst );
+    MPI_Barrier( node_comm_ );
+    atomic_thread_fence( memory_order_seq_cst );
+}
@@ -0,0 +1,103 @@
+#ifndef AGGREGATEDMPIBUFFERS_H
+#define AGGREGATEDMPIBUFFERS_H
+
+#include <mpi.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Field;
+class VectorPatch;
+class SmileiMPI;
+
+//! Ghost cells of a list of fields, for all the patches of the MPI process, exchanged (or summed) with a single
+//! message per neighbor MPI process (Main.aggregate_ghost_messages), instead of one message per patch, field and direction.
+//! The messages are made of blocks of contiguous ghost cells, ordered by (direction, component, sending patch, side)
+//! on both the sending and the receiving sides.
+//! With Main.shared_memory_exchanges, the fields carved in a FieldArena are in shared memory : the blocks of the MPI
+//! processes of the same node are copied directly from their fields, as between the patches of an MPI process.
+//! Only the other blocks are sent in messages.
+class AggregatedMPIbuffers {
+public:
+    AggregatedMPIbuffers();
+    ~AggregatedMPIbuffers();
+
+    //! Kinds of communication : exchange of the ghost cells, or sum (received in Field::MPIbuff.buf,
+    //! then summed by Patch::finalizeSumField)
+    static const int exchange = 0;
+    static const int sum      = 1;
+
+    //! Name of a synchronization, identical on all MPI processes : names of the components of fields (all components
+    //! for nPatches patches), directions dims and kind
+    static std::string phase( std::vector<Field*>& fields, std::vector<unsigned int>& dims, int kind, unsigned int nPatches );
+
+    //! Pack the ghost cells of fields (all components for all patches, as VectorPatch::densities)
+    //! along the directions dims, and post the messages. Must be called by all the threads.
+    void init( std::vector<Field*>& fields, std::vector<unsigned int>& dims, int kind, VectorPatch& vecPatches, SmileiMPI* smpi );
+    //! Wait for the messages and unpack the received ghost cells. Must be called by all the threads.
+    void finalize();
+
+private:
+    //! Ghost cells of a field, along iDim between start and start+width, sent to or received from a neighbor MPI process
+    struct Block {
+        Field* field;
+        unsigned int iDim, start, width;
+        //! Destination of a received block of the sum, instead of the field
+        double* buf;
+        //! Ordering key, identical for a block sent and received
+        unsigned int comp, side;
+        int hindex;
+        //! Neighbor MPI process, its index in send_ranks_ or recv_ranks_, and position of the block in the buffer
+        int rank;
+        unsigned int message, offset;
+        //! Block of a field in shared memory : position of the field in the arenas, data of the field of the sending
+        //! patch, and start of the block in it
+        std::size_t arena_offset;
+        const double* remote;
+        unsigned int remote_start;
+    };
+    static bool before( const Block& a, const Block& b );
+    static unsigned int blockSize( const Block& block );
+    //! Copy the slab of a block from in to out, arrays of in_n and out_n cells along iDim (and of the cells of the field
+    //! along the other directions), where the slab starts at the cells in_start and out_start
+    static void copy( const Block& block, const double* in, unsigned int in_n, unsigned int in_start,
+                      double* out, unsigned int out_n, unsigned int out_start );
+    static void pack  ( const Block& block, double* out );
+    static void unpack( const Block& block, const double* in );
+    static void copyShared( const Block& block );
+
+    //! Check that the plan corresponds to the current patches and fields, otherwise rebuild it (return true)
+    bool update( std::vector<Field*>& fields, std::vector<unsigned int>& dims, int kind, VectorPatch& vecPatches, SmileiMPI* smpi );
+    //! Group the blocks by neighbor MPI process and compute their position in the messages
+    static void order( std::vector<Block>& blocks, std::vector<int>& ranks, std::vector<unsigned int>& displs );
+
+    //! Signature of the plan : fields and their data, hindex and MPI environment of the patches, directions and kind
+    std::vector<Field*> fields_;
+    std::vector<double*> data_;
+    std::vector<unsigned int> env_;
+    std::vector<unsigned int> dims_;
+    int kind_;
+
+    std::vector<Block> send_blocks_, recv_blocks_;
+    //! Neighbor MPI processes, and displacements of their messages in send_buffer_, recv_buffer_
+    std::vector<int> send_ranks_, recv_ranks_;
+    std::vector<unsigned int> send_displs_, recv_displs_;
+    std::vector<double> send_buffer_, recv_buffer_;
+    std::vector<MPI_Request> requests_;
+
+    MPI_Comm comm_;
+    int tag_;
+
+    // Shared memory (Main.shared_memory_exchanges)
+    // --------------------------------------------
+    //! Blocks received from the MPI processes of the node, copied from the fields of the sending patches
+    std::vector<Block> shared_blocks_;
+    //! Collective on the node : find the arena of the sending patch of the shared blocks, through a directory of the
+    //! arenas of each MPI process (hindex and serial of its patches) in a MPI-3 shared memory window
+    void attachArenas( VectorPatch& vecPatches, SmileiMPI* smpi );
+    //! Synchronization of the MPI processes of the node, ordering the accesses to the shared fields
+    void nodeBarrier();
+    MPI_Comm node_comm_;
+};
+
+#endif
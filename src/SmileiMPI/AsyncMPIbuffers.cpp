@@ -13,6 +13,17 @@ AsyncMPIbuffers::AsyncMPIbuffers()
 
 AsyncMPIbuffers::~AsyncMPIbuffers()
 {
+    // Persistent requests of fields
+    int finalized;
+    MPI_Finalized( &finalized );
+    if ( finalized )
+        return;
+    if ( exchange_version_.size() ) {
+        freeRequests( srequest );
+        freeRequests( rrequest );
+    }
+    freeRequests( sum_srequest );
+    freeRequests( sum_rrequest );
 }
 
 
@@ -21,9 +32,11 @@ void AsyncMPIbuffers::allocate(unsigned int ndims)
     srequest.resize(ndims);
     rrequest.resize(ndims);
     for (unsigned int i=0 ; i<ndims ; i++) {
-        srequest[i].resize(2);
-        rrequest[i].resize(2);
+        srequest[i].resize(2, MPI_REQUEST_NULL);
+        rrequest[i].resize(2, MPI_REQUEST_NULL);
     }
+    exchange_version_.resize(ndims, 0);
+    exchange_data_   .resize(ndims, NULL);
 
     send_tags_.resize(ndims);
     recv_tags_.resize(ndims);
@@ -38,10 +51,18 @@ void AsyncMPIbuffers::allocate(unsigned int ndims, Field* f, std::vector<unsigne
     if (buf[0][0].size()!=0) return;
     srequest.resize(ndims);
     rrequest.resize(ndims);
+    sum_srequest.resize(ndims);
+    sum_rrequest.resize(ndims);
     for (unsigned int i=0 ; i<ndims ; i++) {
-        srequest[i].resize(2);
-        rrequest[i].resize(2);
+        srequest[i].resize(2, MPI_REQUEST_NULL);
+        rrequest[i].resize(2, MPI_REQUEST_NULL);
+        sum_srequest[i].resize(2, MPI_REQUEST_NULL);
+        sum_rrequest[i].resize(2, MPI_REQUEST_NULL);
     }
+    exchange_version_.resize(ndims, 0);
+    exchange_data_   .resize(ndims, NULL);
+    sum_version_.resize(ndims, 0);
+    sum_data_   .resize(ndims, NULL);
     
     std::vector<unsigned int> oversize2(oversize);
     oversize2[0] *= 2;
@@ -100,6 +121,46 @@ void AsyncMPIbuffers::defineTags(Patch* patch, SmileiMPI* smpi, int tag )
 }
 
 
+bool AsyncMPIbuffers::setupExchange( int iDim, unsigned int MPIenv_version, double* data )
+{
+    return setupRequests( srequest, rrequest, exchange_version_, exchange_data_, iDim, MPIenv_version, data );
+}
+
+
+bool AsyncMPIbuffers::setupSum( int iDim, unsigned int MPIenv_version, double* data )
+{
+    return setupRequests( sum_srequest, sum_rrequest, sum_version_, sum_data_, iDim, MPIenv_version, data );
+}
+
+
+bool AsyncMPIbuffers::setupRequests( std::vector< std::vector<MPI_Request> >& send, std::vector< std::vector<MPI_Request> >& recv,
+                                     std::vector<unsigned int>& version, std::vector<double*>& data, int iDim,
+                                     unsigned int MPIenv_version, double* current_data )
+{
+    if ( (version[iDim]==MPIenv_version) && (data[iDim]==current_data) )
+        return false;
+
+    for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+        if ( send[iDim][iNeighbor] != MPI_REQUEST_NULL )
+            MPI_Request_free( &(send[iDim][iNeighbor]) );
+        if ( recv[iDim][iNeighbor] != MPI_REQUEST_NULL )
+            MPI_Request_free( &(recv[iDim][iNeighbor]) );
+    }
+    version[iDim] = MPIenv_version;
+    data   [iDim] = current_data;
+    return true;
+}
+
+
+void AsyncMPIbuffers::freeRequests( std::vector< std::vector<MPI_Request> >& requests )
+{
+    for (unsigned int iDim=0 ; iDim<requests.size() ; iDim++)
+        for (unsigned int iNeighbor=0 ; iNeighbor<requests[iDim].size() ; iNeighbor++)
+            if ( requests[iDim][iNeighbor] != MPI_REQUEST_NULL )
+                MPI_Request_free( &(requests[iDim][iNeighbor]) );
+}
+
+
 SpeciesMPIbuffers::SpeciesMPIbuffers()
 {
 }
@@ -116,7 +177,8 @@ void SpeciesMPIbuffers::allocate(unsigned int ndims)
     rrequest.resize(ndims);
 
     partRecv.resize(ndims);
-    partSend.resize(ndims);
+    partSendBuffer.resize(ndims);
+    partRecvBuffer.resize(ndims);
 
     part_index_send.resize(ndims);
     part_index_send_sz.resize(ndims);
@@ -126,11 +188,24 @@ void SpeciesMPIbuffers::allocate(unsigned int ndims)
         srequest[i].resize(2);
         rrequest[i].resize(2);
         partRecv[i].resize(2);
-        partSend[i].resize(2);
+        partSendBuffer[i].resize(2);
+        partRecvBuffer[i].resize(2);
         part_index_send[i].resize(2);
         part_index_send_sz[i].resize(2);
         part_index_recv_sz[i].resize(2);
     }
 
+    unsigned int ndir = 1;
+    for (unsigned int i=0 ; i<ndims ; i++)
+        ndir *= 3;
+    direct_partRecv.resize(ndir);
+    direct_partSendBuffer.resize(ndir);
+    direct_partRecvBuffer.resize(ndir);
+    direct_part_index_send.resize(ndir);
+    direct_part_index_send_sz.resize(ndir, 0);
+    direct_part_index_recv_sz.resize(ndir, 0);
+    direct_srequest.resize(ndir, MPI_REQUEST_NULL);
+    direct_rrequest.resize(ndir, MPI_REQUEST_NULL);
+
 }
 
@@ -28,6 +28,27 @@ public:
 
     std::vector< std::vector<int> > send_tags_, recv_tags_;
 
+    //! For fields, srequest and rrequest are the persistent requests (MPI_Send_init, MPI_Recv_init) of the exchange,
+    //! sum_srequest and sum_rrequest those of the sum, sent from the field and received in buf
+    std::vector< std::vector<MPI_Request> > sum_srequest;
+    std::vector< std::vector<MPI_Request> > sum_rrequest;
+
+    //! Tells whether the persistent requests of the exchange (resp. sum) along iDim must be set up before being started :
+    //! they do not exist yet, or the MPI environment of the patch (Patch::MPIenv_version_) or the field data changed.
+    //! Outdated requests are freed.
+    bool setupExchange( int iDim, unsigned int MPIenv_version, double* data );
+    bool setupSum( int iDim, unsigned int MPIenv_version, double* data );
+
+private:
+    bool setupRequests( std::vector< std::vector<MPI_Request> >& send, std::vector< std::vector<MPI_Request> >& recv,
+                        std::vector<unsigned int>& version, std::vector<double*>& data, int iDim,
+                        unsigned int MPIenv_version, double* current_data );
+    void freeRequests( std::vector< std::vector<MPI_Request> >& requests );
+
+    //! MPI environment and field data for which the persistent requests of each direction were set up (0 = none)
+    std::vector<unsigned int> exchange_version_, sum_version_;
+    std::vector<double*> exchange_data_, sum_data_;
+
 };
 
 class SpeciesMPIbuffers : public AsyncMPIbuffers {
@@ -37,10 +58,13 @@ public:
 
     void allocate(unsigned int nDim_field) ;
 
-    //! ndim vectors of 2 sent packets of particles (1 per direction) 
+    //! ndim vectors of 2 received packets of particles (1 per direction), from patches of the same MPI process
     std::vector< std::vector<Particles > > partRecv;
-    //! ndim vectors of 2 received packets of particles (1 per direction) 
-    std::vector< std::vector<Particles > > partSend;
+    //! ndim vectors of 2 packed particles (Particles::pack) sent to / received from MPI neighbors (1 per direction),
+    //! their capacity is kept from one exchange to the next. Received particles are unpacked in the species
+    //! (Species::sort_part), a non-empty partRecvBuffer replacing partRecv
+    std::vector< std::vector< PackedParticles > > partSendBuffer;
+    std::vector< std::vector< PackedParticles > > partRecvBuffer;
 
     //! ndim vectors of 2 vectors of index particles to send (1 per direction) 
     //!   - not sent
@@ -51,6 +75,17 @@ public:
     //! ndim vectors of 2 numbers of particles to receive (1 per direction) 
     std::vector< std::vector< int > > part_index_recv_sz;
 
+    //! Buffers of the direct exchange (Main.direct_particle_exchange) : 3^ndim packets of particles,
+    //! indexed by the direction of the neighbor (see Patch::direct_neighbor_)
+    std::vector<Particles> direct_partRecv;
+    std::vector<PackedParticles> direct_partSendBuffer;
+    std::vector<PackedParticles> direct_partRecvBuffer;
+    std::vector< std::vector<int> > direct_part_index_send;
+    std::vector<int> direct_part_index_send_sz;
+    std::vector<int> direct_part_index_recv_sz;
+    std::vector<MPI_Request> direct_srequest;
+    std::vector<MPI_Request> direct_rrequest;
+
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <unistd.h>
 
 #include "Params.h"
 #include "Tools.h"
@@ -15,6 +16,7 @@
 #include "ElectroMagnBC2D_SM.h"
 #include "ElectroMagnBC3D_SM.h"
 #include "Field.h"
+#include "FieldArena.h"
 
 #include "Species.h"
 #include "PeekAtSpecies.h"
@@ -68,6 +70,13 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
 
+    if ( SMILEI_COMM_GHOSTS != MPI_COMM_NULL )
+        MPI_Comm_free( &SMILEI_COMM_GHOSTS );
+    if ( SMILEI_COMM_PARTICLES != MPI_COMM_NULL )
+        MPI_Comm_free( &SMILEI_COMM_PARTICLES );
+    if ( SMILEI_COMM_NODE != MPI_COMM_NULL )
+        MPI_Comm_free( &SMILEI_COMM_NODE );
+
     MPI_Finalize();
 
 } // END SmileiMPI::~SmileiMPI
@@ -141,6 +150,38 @@ void SmileiMPI::init( Params& params, DomainDecomposition* domain_decomposition
             MESSAGE(1,"applied topology for periodic BCs in "<<"xyz"[i]<<"-direction");
         }
     }
+
+    if ( params.aggregate_ghost_messages )
+        MPI_Comm_dup( SMILEI_COMM_WORLD, &SMILEI_COMM_GHOSTS );
+    if ( params.direct_particle_exchange )
+        MPI_Comm_dup( SMILEI_COMM_WORLD, &SMILEI_COMM_PARTICLES );
+
+    // MPI processes of the node, and their rank in the node communicator
+    if ( params.shared_memory_exchanges ) {
+        MPI_Comm_split_type( SMILEI_COMM_WORLD, MPI_COMM_TYPE_SHARED, smilei_rk, MPI_INFO_NULL, &SMILEI_COMM_NODE );
+        MPI_Group world_group, node_group;
+        MPI_Comm_group( SMILEI_COMM_WORLD, &world_group );
+        MPI_Comm_group( SMILEI_COMM_NODE , &node_group  );
+        vector<int> world_rank( smilei_sz );
+        for (int rank=0 ; rank<smilei_sz ; rank++)
+            world_rank[rank] = rank;
+        node_rank_.resize( smilei_sz );
+        MPI_Group_translate_ranks( world_group, smilei_sz, &world_rank[0], node_group, &node_rank_[0] );
+        for (int rank=0 ; rank<smilei_sz ; rank++)
+            if ( node_rank_[rank] == MPI_UNDEFINED )
+                node_rank_[rank] = -1;
+        MPI_Group_free( &world_group );
+        MPI_Group_free( &node_group  );
+        // Shared field arenas named after the first MPI process of the node, unique on the node
+        int pid = getpid();
+        MPI_Bcast( &pid, 1, MPI_INT, 0, SMILEI_COMM_NODE );
+        ostringstream prefix;
+        prefix << "/smilei-" << pid << "-";
+        FieldArena::share( prefix.str(), smilei_rk );
+        int node_size;
+        MPI_Comm_size( SMILEI_COMM_NODE, &node_size );
+        MESSAGE(1,"Fields shared in memory between the " << node_size << " MPI processes of the node");
+    }
 } // END init
 
 
@@ -338,7 +379,9 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     unsigned int ncells_perpatch, j;
     int Ncur;
     double Tload,Tload_loc,Tcur, cells_load, target, Tscan, largest_patch_loc, largest_patch;
+    double Tnew_loc, Tnew_max, cost_loc, cost_max, cost_tot;
     bool recompute_tload = true;
+    bool measured_cost = params.measured_cost;
     //Load of a cell = cell_load*load of a particle.
     //Load of a frozen particle = frozen_particle_load*load of a particle.
     std::vector<double> Lp, Lp_left, Lp_right;
@@ -362,7 +405,12 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     if (smilei_rk > 0) Lp_left.resize(patch_count[smilei_rk-1]);
     if (smilei_rk < smilei_sz-1) Lp_right.resize(patch_count[smilei_rk+1]);
 
-
+    //Wall-clock time measured in the patches since the last balancing
+    cost_loc = 0.;
+    for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++)
+        cost_loc += vecpatches(ipatch)->cost;
+    MPI_Allreduce(&cost_loc, &cost_max, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(&cost_loc, &cost_tot, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
 
     while (recompute_tload){
 
@@ -375,9 +423,31 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
             for (unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++) {
                 Lp[ipatch] += vecpatches(ipatch)->vecSpecies[ispecies]->getNbrOfParticles()*(1+(params.frozen_particle_load-1)*(time_dual < vecpatches(ipatch)->vecSpecies[ispecies]->time_frozen)) ;
             }
-            Tload_loc += Lp[ipatch];
         }
 
+        if (measured_cost) {
+            //Patches not measured yet (new patches of the moving window) keep the model load,
+            //converted in seconds with the cost per unit of load of the measured patches
+            double measured[2] = {0., 0.}, measured_tot[2];
+            for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++){
+                if (vecpatches(ipatch)->cost > 0.) {
+                    measured[0] += vecpatches(ipatch)->cost;
+                    measured[1] += Lp[ipatch];
+                }
+            }
+            MPI_Allreduce(measured, measured_tot, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            if (measured_tot[0] > 0.) {
+                for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++)
+                    Lp[ipatch] = vecpatches(ipatch)->cost > 0. ? vecpatches(ipatch)->cost : Lp[ipatch]*measured_tot[0]/measured_tot[1];
+            } else {
+                //Nothing measured, fall back to the load model
+                measured_cost = false;
+            }
+        }
+
+        for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++)
+            Tload_loc += Lp[ipatch];
+
         largest_patch_loc = *max_element(Lp.begin(), Lp.end());
 
         //Tscan = total load carried by previous ranks and me
@@ -391,7 +461,11 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
        
         //This algorithm does not support single patches having a load larger than the target load per MPI rank.
         //If this happens, the code multiplies the cell load coefficient in order to be able to continue.  
-        if (largest_patch >= Tload){
+        if (largest_patch >= Tload && measured_cost){
+            //A measured cost cannot be tuned, the overloaded patch will be alone on its rank
+            WARNING("Dynamic Load balancing: the measured cost of a patch is larger than the target load per MPI rank. Try using smaller patches or less MPI ranks.");
+            recompute_tload = false;
+        }else if (largest_patch >= Tload){
             params.cell_load *= 2.;    
             cells_load = ncells_perpatch*params.cell_load ;
             WARNING("Dynamic Load balancing had to increase cell load coefficient because of an overloaded patch with respect to the target load per MPI rank. Try using smaller patches or less MPI ranks.");
@@ -418,6 +492,9 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     if (smilei_rk < smilei_sz-1)
         MPI_Wait(&request0, &status);
 
+    //Load of current rank after the balancing
+    Tnew_loc = Tload_loc;
+
     if (smilei_rk > 0){
         //Tcur is now initialized as the total load currently carried by previous ranks.
         Tcur = Tscan - Tload_loc;
@@ -427,6 +504,7 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
             j = Lp_left.size()-1;
             while (abs(Tcur-target) > abs(Tcur-Lp_left[j] - target) && j>0){ //Leave at least 1 patch to my neighbour.
                 Tcur -= Lp_left[j];
+                Tnew_loc += Lp_left[j];
                 j--;
                 Ncur++;
             }
@@ -435,6 +513,7 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
             j = 0;
             while ( (abs(Tcur-target) > abs(Tcur+Lp[j]-target)) && (j < (unsigned int)patch_count[smilei_rk]-1) ){ //Keep at least 1 patch from my original set of patches
                 Tcur += Lp[j];
+                Tnew_loc -= Lp[j];
                 j++;
                 Ncur --;
             }
@@ -451,6 +530,7 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
             unsigned int j = 0;
             while ( (abs(Tcur-target) > abs(Tcur+Lp_right[j] - target)) && (j<(unsigned int)patch_count[smilei_rk+1] - 1) ){ //Leave at least 1 patch to my neighbour
                 Tcur += Lp_right[j];
+                Tnew_loc += Lp_right[j];
                 j++;
                 Ncur++;
             }
@@ -460,6 +540,7 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
             j = patch_count[smilei_rk]-1;
             while (abs(Tcur-target) > abs(Tcur-Lp[j]-target) && j > 0){ //Keep at least 1 patch from my original set of patches
                 Tcur -= Lp[j];
+                Tnew_loc -= Lp[j];
                 j--;
                 Ncur --;
             }
@@ -473,6 +554,9 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     //Ncur now has to be gathered to all as target_patch_count[smilei_rk]
     MPI_Allgather(&Ncur,1,MPI_INT,&patch_count[0], 1, MPI_INT,MPI_COMM_WORLD);
 
+    //Largest load of a rank with the new distribution, as predicted by the load model
+    MPI_Allreduce(&Tnew_loc, &Tnew_max, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
     patch_refHindexes[0] = 0;
     for ( int rk=1 ; rk<smilei_sz ; rk++)    
         patch_refHindexes[rk] = patch_refHindexes[rk-1] + patch_count[rk-1];
@@ -480,6 +564,12 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     //Write patch_load.txt
     if (smilei_rk==0) {
         fout << "\tt = " << time_dual << endl;
+        fout << " load model = " << (measured_cost ? "measured cost" : "cells and particles") << endl;
+        //Imbalance = largest load of a rank / average load of a rank
+        if (cost_tot > 0.)
+            fout << " achieved imbalance (measured since last balancing) = " << cost_max*smilei_sz/cost_tot << endl;
+        if (Tload > 0.)
+            fout << " predicted imbalance after balancing = " << Tnew_max/Tload << endl;
         for (int irk=0;irk<smilei_sz;irk++)
             fout << " patch_count[" << irk << "] = " << patch_count[irk] << endl;
         fout.close();
@@ -508,50 +598,6 @@ int SmileiMPI::hrank(int h)
 } // END hrank
 
 
-// ----------------------------------------------------------------------
-// Create MPI type to exchange all particles properties of particles
-// ----------------------------------------------------------------------
-MPI_Datatype SmileiMPI::createMPIparticles( Particles* particles )
-{
-    int nbrOfProp = particles->double_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
-
-    MPI_Aint address[nbrOfProp];
-    for ( unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->double_prop[iprop]))[0] ), &(address[iprop]) );
-    for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->short_prop[iprop]))[0] ), &(address[particles->double_prop.size()+iprop]) );
-    for ( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->uint64_prop[iprop]))[0] ), &(address[particles->double_prop.size()+particles->short_prop.size()+iprop]) );
-
-    int nbr_parts[nbrOfProp];
-    // number of elements per property
-    for (int i=0 ; i<nbrOfProp ; i++)
-        nbr_parts[i] = particles->size();
-
-    MPI_Aint disp[nbrOfProp];
-    // displacement between 2 properties
-    disp[0] = 0;
-    for (int i=1 ; i<nbrOfProp ; i++)
-        disp[i] = address[i] - address[0];
-
-    MPI_Datatype partDataType[nbrOfProp];
-    // define MPI type of each property, default is DOUBLE
-    for ( unsigned int i=0 ; i<particles->double_prop.size() ; i++)
-        partDataType[i] = MPI_DOUBLE;
-    for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+iprop] = MPI_SHORT;
-    for ( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+particles->short_prop.size()+iprop] = MPI_UNSIGNED_LONG_LONG;
-
-    MPI_Datatype typeParticlesMPI;
-    MPI_Type_create_struct( nbrOfProp, &(nbr_parts[0]), &(disp[0]), &(partDataType[0]), &typeParticlesMPI);
-    MPI_Type_commit( &typeParticlesMPI );
-
-    return typeParticlesMPI;
-
-} // END createMPIparticles
-
-
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // -----------------------------------------       PATCH SEND / RECV METHODS        ------------------------------------
@@ -568,7 +614,6 @@ void SmileiMPI::isend(Patch* patch, int to, int tag, Params& params)
     for (int ispec=0 ; ispec<(int)patch->vecSpecies.size() ; ispec++){
         isend( &(patch->vecSpecies[ispec]->bmax), to, tag+2*ispec+1, patch->requests_[2*ispec] );
         if ( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ){
-            patch->vecSpecies[ispec]->exchangePatch = createMPIparticles( patch->vecSpecies[ispec]->particles );
             isend( patch->vecSpecies[ispec]->particles, to, tag+2*ispec, patch->vecSpecies[ispec]->exchangePatch, patch->requests_[2*ispec+1] );
         }
     }
@@ -617,21 +662,14 @@ void SmileiMPI::waitall(Patch* patch)
         //patch->requests_[ireq] = MPI_REQUEST_NULL;
     }
 
+    // Release the packed particles, the patch is about to be deleted
     for (int ispec=0 ; ispec<(int)patch->vecSpecies.size() ; ispec++)
-    {
-        if ( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
-            if (patch->vecSpecies[ispec]->exchangePatch != MPI_DATATYPE_NULL) {
-                MPI_Type_free( &(patch->vecSpecies[ispec]->exchangePatch) );
-                patch->vecSpecies[ispec]->exchangePatch = MPI_DATATYPE_NULL;
-            }
-        }
-    }
+        PackedParticles().swap( patch->vecSpecies[ispec]->exchangePatch );
 
 }
 
 void SmileiMPI::recv(Patch* patch, int from, int tag, Params& params)
 {
-    MPI_Datatype recvParts;
     int nbrOfPartsRecv;
 
     // Count number max of comms :int tag
@@ -646,12 +684,9 @@ void SmileiMPI::recv(Patch* patch, int from, int tag, Params& params)
         //Prepare patch for receiving particles
         nbrOfPartsRecv = patch->vecSpecies[ispec]->bmax.back();
         patch->vecSpecies[ispec]->particles->initialize( nbrOfPartsRecv, params.nDim_particle );
-        //Receive particles
-        if ( nbrOfPartsRecv > 0 ) {
-            recvParts = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            recv( patch->vecSpecies[ispec]->particles, from, tag+2*ispec, recvParts );
-            MPI_Type_free( &(recvParts) );
-        }
+        //Receive particles, unpacked directly in their bins
+        if ( nbrOfPartsRecv > 0 )
+            recv( patch->vecSpecies[ispec]->particles, from, tag+2*ispec );
     }
 
     maxtag += 2*patch->vecSpecies.size();
@@ -692,17 +727,22 @@ void SmileiMPI::recv(Patch* patch, int from, int tag, Params& params)
 } // END recv ( Patch )
 
 
-void SmileiMPI::isend(Particles* particles, int to, int tag, MPI_Datatype typePartSend, MPI_Request& request)
+void SmileiMPI::isend(Particles* particles, int to, int tag, PackedParticles& buffer, MPI_Request& request)
 {
-    MPI_Isend( &(particles->position(0,0)), 1, typePartSend, to, tag, MPI_COMM_WORLD, &request );
+    particles->pack( 0, particles->size(), buffer );
+    MPI_Isend( &buffer[0], buffer.size(), MPI_BYTE, to, tag, MPI_COMM_WORLD, &request );
 
 } // END isend( Particles )
 
 
-void SmileiMPI::recv(Particles* particles, int to, int tag, MPI_Datatype typePartRecv)
+// The particles must be initialized with the number of particles to receive
+void SmileiMPI::recv(Particles* particles, int from, int tag)
 {
     MPI_Status status;
-    MPI_Recv( &(particles->position(0,0)), 1, typePartRecv, to, tag, MPI_COMM_WORLD, &status );
+    PackedParticles buffer;
+    buffer.resize( particles->packedSize( particles->size() ) );
+    MPI_Recv( &buffer[0], buffer.size(), MPI_BYTE, from, tag, MPI_COMM_WORLD, &status );
+    particles->unpack( buffer, 0 );
 
 } // END recv( Particles )
 
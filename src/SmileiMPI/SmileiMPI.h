@@ -59,9 +59,6 @@ public:
      // Returns the rank of the MPI process currently owning patch h.
     int hrank(int h);
 
-    // Create MPI type to exchange all particles properties of particles
-    MPI_Datatype createMPIparticles( Particles* particles );
-
 
     // PATCH SEND / RECV METHODS
     //     - during load balancing process
@@ -71,8 +68,9 @@ public:
     void waitall(Patch* patch);
     void recv (Patch* patch, int from, int hindex, Params& params);
 
-    void isend(Particles* particles, int to   , int hindex, MPI_Datatype datatype, MPI_Request& request);
-    void recv (Particles* partictles, int from, int hindex, MPI_Datatype datatype);
+    // Particles are packed in a contiguous buffer (Particles::pack), which must be kept until the send completes
+    void isend(Particles* particles, int to   , int hindex, PackedParticles& buffer, MPI_Request& request);
+    void recv (Particles* particles, int from, int hindex);
     void isend(std::vector<int>* vec, int to  , int hindex, MPI_Request& request);
     void recv (std::vector<int> *vec, int from, int hindex);
     
@@ -125,6 +123,29 @@ public:
         return SMILEI_COMM_WORLD;
     }
 
+    //! Return the communicator of the aggregated ghost messages (Main.aggregate_ghost_messages)
+    inline MPI_Comm getGhostComm()
+    {
+        return SMILEI_COMM_GHOSTS;
+    }
+
+    //! Return the communicator of the direct particle exchange (Main.direct_particle_exchange)
+    inline MPI_Comm getParticleComm()
+    {
+        return SMILEI_COMM_PARTICLES;
+    }
+
+    //! Return the communicator of the MPI processes of the node (Main.shared_memory_exchanges), MPI_COMM_NULL if not used
+    inline MPI_Comm getNodeComm()
+    {
+        return SMILEI_COMM_NODE;
+    }
+    //! Rank in the node communicator of the MPI process rank, -1 if it is on another node
+    inline int nodeRank( int rank )
+    {
+        return node_rank_.size() ? node_rank_[rank] : -1;
+    }
+
     //! Return MPI_Comm_size
     inline int getOMPMaxThreads() {
         return smilei_omp_max_threads;
@@ -169,6 +190,14 @@ public:
 protected:
     //! Global MPI Communicator
     MPI_Comm SMILEI_COMM_WORLD;
+    //! Duplicate of SMILEI_COMM_WORLD for the aggregated ghost messages, whose tags can not collide with the others
+    MPI_Comm SMILEI_COMM_GHOSTS = MPI_COMM_NULL;
+    //! Duplicate of SMILEI_COMM_WORLD for the direct particle exchange, which overlaps the exchanges of the fields
+    MPI_Comm SMILEI_COMM_PARTICLES = MPI_COMM_NULL;
+    //! MPI processes sharing the memory of the node
+    MPI_Comm SMILEI_COMM_NODE = MPI_COMM_NULL;
+    //! Rank in SMILEI_COMM_NODE of each MPI process, -1 if on another node
+    std::vector<int> node_rank_;
 
     //! Number of MPI process in the current communicator
     int smilei_sz;
@@ -0,0 +1,116 @@
+// --------------------------------------------------------------------------------------------------------------------
+//
+//! \file DynamicsKernel.h
+//
+//! \brief Fused particle dynamics (interpolation, push, boundary conditions, projection) with static dispatch
+//
+// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef DYNAMICSKERNEL_H
+#define DYNAMICSKERNEL_H
+
+#include "Params.h"
+#include "Species.h"
+#include "Particles.h"
+#include "PartBoundCond.h"
+#include "PartWall.h"
+#include "ElectroMagn.h"
+#include "Interpolator.h"
+#include "Projector.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class DynamicsKernel : fused dynamics of all the bins of a species, one virtual call per species and per timestep
+//  --------------------------------------------------------------------------------------------------------------------
+class DynamicsKernel {
+public:
+    DynamicsKernel() {};
+    virtual ~DynamicsKernel() {};
+
+    //! Interpolate, push, apply the boundary conditions and project the particles of species, chunk by chunk
+    virtual void operator() (Species* species, ElectroMagn* EMfields, Interpolator* Interp, Projector* Proj,
+                             Params &params, bool diag_flag, PartWalls* partWalls, unsigned int ispec) = 0;
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class DynamicsKernelT : DynamicsKernel instantiated for the dimension, the interpolator, the pusher and the projector.
+//! Operators are called through their concrete type, the pusher and the boundary conditions are inlined in the loop.
+//! The set of boundary conditions (exchange only, or physical conditions on this patch) is chosen once per call.
+//  --------------------------------------------------------------------------------------------------------------------
+template<int nDim, class InterpT, class PushT, class ProjT>
+class DynamicsKernelT final : public DynamicsKernel {
+public:
+    DynamicsKernelT() {};
+    ~DynamicsKernelT() {};
+
+    void operator() (Species* species, ElectroMagn* EMfields, Interpolator* Interp, Projector* Proj,
+                     Params &params, bool diag_flag, PartWalls* partWalls, unsigned int ispec) override
+    {
+        InterpT* interp = static_cast<InterpT*>( Interp );
+        PushT*   push   = static_cast<PushT*>  ( species->Push );
+        ProjT*   proj   = static_cast<ProjT*>  ( Proj );
+
+        // Conditions pointers may change during the simulation (moving window)
+        if ( species->partBoundCond->isExchangeOnly() )
+            run<true >( species, EMfields, interp, push, proj, params, diag_flag, partWalls, ispec );
+        else
+            run<false>( species, EMfields, interp, push, proj, params, diag_flag, partWalls, ispec );
+    }
+
+private:
+    template<bool exchange_only>
+    inline void run( Species* species, ElectroMagn* EMfields, InterpT* interp, PushT* push, ProjT* proj,
+                     Params &params, bool diag_flag, PartWalls* partWalls, unsigned int ispec )
+    {
+        const int nchunk = Species::fused_chunk_size;
+        double Epart[3*nchunk], Bpart[3*nchunk], invgf[nchunk], delta[3*nchunk];
+        int iold[3*nchunk];
+
+        Particles &particles = *species->particles;
+        PartBoundCond* partBoundCond = species->partBoundCond;
+        std::vector<int> &bmin = species->bmin;
+        std::vector<int> &bmax = species->bmax;
+        double mass = species->mass;
+
+        double ener_iPart(0.);
+        double nrj_lost(0.);
+
+        for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++) {
+            for (int istart = bmin[ibin] ; istart < bmax[ibin] ; istart += nchunk) {
+                int iend = std::min(istart+nchunk, bmax[ibin]);
+
+                // Interpolate the fields at the particle position
+                interp->InterpT::interpolate_chunk(EMfields, particles, istart, iend, nchunk, Epart, Bpart, iold, delta);
+
+                // Push the particles
+                push->template push_chunk_static<nDim>(particles, istart, iend, nchunk, Epart, Bpart, invgf);
+
+                // Apply wall and boundary conditions
+                for(unsigned int iwall=0; iwall<partWalls->size(); iwall++) {
+                    for (int iPart=istart ; iPart<iend; iPart++ ) {
+                        double dtgf = params.timestep * invgf[iPart-istart];
+                        if ( !(*partWalls)[iwall]->apply(particles, iPart, species, dtgf, ener_iPart)) {
+                            nrj_lost += mass * ener_iPart;
+                        }
+                    }
+                }
+                for (int iPart=istart ; iPart<iend; iPart++ ) {
+                    if ( !partBoundCond->apply<nDim, exchange_only>( particles, iPart, species, ener_iPart ) ) {
+                        species->addPartInExchList( iPart );
+                        // Particles only exchanged with a neighbour patch carry their energy along
+                        if (!exchange_only)
+                            nrj_lost += mass * ener_iPart;
+                    }
+                }
+
+                // Project currents if not a Test species and charges as well if a diag is needed.
+                if (!particles.is_test)
+                    proj->ProjT::project_chunk(EMfields, particles, istart, iend, nchunk, iold, delta, invgf, ibin, species->clrw, diag_flag, species->b_dim, ispec);
+            }
+        }
+
+        species->nrj_bc_lost += nrj_lost;
+    }
+
+};
+
+#endif
@@ -0,0 +1,75 @@
+// --------------------------------------------------------------------------------------------------------------------
+//
+//! \file DynamicsKernelFactory.h
+//
+//! \brief Class DynamicsKernelFactory that chooses the pre-instantiated fused dynamics kernel of a species
+//
+// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef DYNAMICSKERNELFACTORY_H
+#define DYNAMICSKERNELFACTORY_H
+
+#include "DynamicsKernel.h"
+
+#include "Interpolator2D2Order.h"
+#include "Interpolator3D2Order.h"
+#include "PusherBoris.h"
+#include "PusherVay.h"
+#include "PusherHigueraCary.h"
+#include "Projector2D2Order.h"
+#include "Projector3D2Order.h"
+
+#include "Params.h"
+#include "Species.h"
+
+#include "Tools.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class DynamicsKernelFactory
+//
+//! \brief Instantiates DynamicsKernelT for the combination (geometry, interpolation order, pusher) of the species.
+//! The interpolator and the projector created by InterpolatorFactory and ProjectorFactory for this combination
+//! must be the ones of the kernel : order 2, no vectorization, no spectral solver (checked in SpeciesFactory).
+//  --------------------------------------------------------------------------------------------------------------------
+class DynamicsKernelFactory {
+public:
+    static DynamicsKernel* create(Params& params, Species * species) {
+        DynamicsKernel* kernel = NULL;
+
+        if (!species->fused_dynamics)
+            return kernel;
+
+        if ( ( params.geometry == "2Dcartesian" ) && ( params.interpolation_order == (unsigned int)2 ) ) {
+            kernel = create<2, Interpolator2D2Order, Projector2D2Order>( species );
+        }
+        else if ( ( params.geometry == "3Dcartesian" ) && ( params.interpolation_order == (unsigned int)2 ) ) {
+            kernel = create<3, Interpolator3D2Order, Projector3D2Order>( species );
+        }
+        else {
+            ERROR( "For species " << species->name << ": no fused dynamics for geometry "
+                   << params.geometry << ", Order : " << params.interpolation_order );
+        }
+
+        return kernel;
+    }
+
+private:
+    template<int nDim, class InterpT, class ProjT>
+    static DynamicsKernel* create(Species * species) {
+        DynamicsKernel* kernel = NULL;
+
+        if ( species->pusher == "boris" )
+            kernel = new DynamicsKernelT<nDim, InterpT, PusherBoris, ProjT>();
+        else if ( species->pusher == "vay" )
+            kernel = new DynamicsKernelT<nDim, InterpT, PusherVay, ProjT>();
+        else if ( species->pusher == "higueracary" )
+            kernel = new DynamicsKernelT<nDim, InterpT, PusherHigueraCary, ProjT>();
+        else
+            ERROR( "For species " << species->name << ": no fused dynamics for pusher `" << species->pusher << "`" );
+
+        return kernel;
+    }
+
+};
+
+#endif
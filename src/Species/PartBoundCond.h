@@ -101,11 +101,45 @@ public:
         return keep_part;
     };
 
+    //! True if no physical condition applies on this patch : particles leaving the domain are only exchanged
+    inline bool isExchangeOnly() const {
+        return bc_xmin==NULL && bc_xmax==NULL && bc_ymin==NULL && bc_ymax==NULL && bc_zmin==NULL && bc_zmax==NULL;
+    }
+
+    //! Same as apply with the dimension and the set of conditions known at compile time (static dynamics kernels).
+    //! If exchange_only, the conditions pointers are not tested, see isExchangeOnly.
+    template<int nDim, bool exchange_only>
+    inline int apply( Particles &particles, int ipart, Species *species, double &nrj_iPart ) {
+        int keep_part = apply_axis<exchange_only>( particles, ipart, 0, x_min, x_max, bc_xmin, bc_xmax, species, nrj_iPart );
+        if (nDim >= 2)
+            keep_part *= apply_axis<exchange_only>( particles, ipart, 1, y_min, y_max, bc_ymin, bc_ymax, species, nrj_iPart );
+        if (nDim == 3)
+            keep_part *= apply_axis<exchange_only>( particles, ipart, 2, z_min, z_max, bc_zmin, bc_zmax, species, nrj_iPart );
+        return keep_part;
+    };
+
     ////! Set the condition window if restart (patch position not read)
     //inline void updateMvWinLimits( double x_moved ) {
     //}
 
 private:
+    //! Conditions along the axis idim, bc_min/bc_max are bc_xmin/bc_xmax, bc_ymin/bc_ymax or bc_zmin/bc_zmax
+    template<bool exchange_only>
+    inline int apply_axis( Particles &particles, int ipart, int idim, double pos_min, double pos_max,
+                           int (*bc_min)( Particles &, int, int, double, Species *, double & ),
+                           int (*bc_max)( Particles &, int, int, double, Species *, double & ),
+                           Species *species, double &nrj_iPart ) {
+        if ( particles.position(idim, ipart) <  pos_min ) {
+            if (exchange_only || bc_min==NULL) return 0;
+            return (*bc_min)( particles, ipart, idim, 2.*pos_min, species, nrj_iPart );
+        }
+        else if ( particles.position(idim, ipart) >= pos_max ) {
+            if (exchange_only || bc_max==NULL) return 0;
+            return (*bc_max)( particles, ipart, idim, 2.*pos_max, species, nrj_iPart );
+        }
+        return 1;
+    };
+
     //! Min value of the x coordinate of particles on the current processor
     //! Real value, oversize is not considered (same for all)
     double x_min;
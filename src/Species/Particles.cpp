@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <algorithm>
 
 #include "Params.h"
 #include "Patch.h"
@@ -17,7 +18,8 @@ using namespace std;
 // Constructor for Particle
 // ---------------------------------------------------------------------------------------------------------------------
 Particles::Particles():
-tracked(false)
+tracked(false),
+capacity_hint(0)
 {
     Position.resize(0);
     Position_old.resize(0);
@@ -192,6 +194,9 @@ void Particles::shrink_to_fit( unsigned int nDim )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::clear()
 {
+    // Keep track of the peak number of particles for the capacity policy
+    capacity_hint = std::max( capacity_hint, size() );
+
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         double_prop[iprop]->clear();
 
@@ -294,6 +299,104 @@ void Particles::erase_particle_trail(unsigned int ipart)
         (*uint64_prop[iprop]).erase( (*uint64_prop[iprop]).begin()+ipart, (*uint64_prop[iprop]).end() );
 
 }
+// ---------------------------------------------------------------------------------------------------------------------
+// Suppress the particles of bin ibin with a null weight (decayed photons, merged particles)
+// The last existing particles of the bin fill the holes, the following bins are shifted
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::erase_null_weight( int ibin, int nbin, int * bmin, int * bmax )
+{
+    if (bmax[ibin] <= bmin[ibin])
+        return;
+
+    // Backward loop over the particles to find the last existing particle
+    int last_index = bmax[ibin]-1;
+    while ( (last_index >= bmin[ibin]) && (Weight[last_index] <= 0) )
+        last_index--;
+
+    // Backward loop over the particles to fill the holes in the particle array
+    for (int ipart=last_index-1 ; ipart>=bmin[ibin]; ipart-- ) {
+        if (Weight[ipart] <= 0) {
+            // The last existing particle comes to the position of the deleted one
+            overwrite_part(last_index,ipart);
+            last_index--;
+        }
+    }
+
+    // Removal of the particles
+    int nb_deleted = bmax[ibin]-last_index-1;
+    if (nb_deleted > 0) {
+        erase_particle(last_index+1,nb_deleted);
+        bmax[ibin] = last_index+1;
+        for (int ii=ibin+1; ii<nbin; ii++) {
+            bmin[ii] -= nb_deleted;
+            bmax[ii] -= nb_deleted;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Splice the particles of source sorted by bin (source_order, first_source[ibin]) into the bins of dest
+// Bins are processed from the last one so that each one is moved only once towards the end of the array
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+static void splice_in_bins( std::vector<T> &dest, const std::vector<T> &source, const std::vector<unsigned int> &source_order,
+                            const std::vector<int> &first_source, int nbin, int * bmin, int * bmax )
+{
+    int nsource = source_order.size();
+    int old_size = dest.size();
+    dest.resize( old_size + nsource );
+
+    // Particles after the last bin (if any) are shifted by all the new particles
+    std::copy_backward( dest.begin()+bmax[nbin-1], dest.begin()+old_size, dest.end() );
+
+    for (int ibin=nbin-1 ; ibin>=0 ; ibin--) {
+        // Shift of this bin = number of new particles in the previous bins
+        int shift = first_source[ibin];
+        if (shift > 0)
+            std::copy_backward( dest.begin()+bmin[ibin], dest.begin()+bmax[ibin], dest.begin()+bmax[ibin]+shift );
+        for (int k=first_source[ibin] ; k<first_source[ibin+1] ; k++)
+            dest[bmax[ibin]+k] = source[source_order[k]];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Insert all the particles of source_particles at the end of their bin source_bin[i]
+//   - counting sort of the new particles by bin (prefix sum of the counts per bin)
+//   - each property is resized once and spliced in one pass, instead of one insertion per particle
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::insert_particles_in_bins( Particles &source_particles, const std::vector<unsigned int> &source_bin, int nbin, int * bmin, int * bmax )
+{
+    unsigned int nsource = source_bin.size();
+    if ( nsource == 0 || nbin == 0 ) return;
+
+    // Index of the first new particle of each bin in source_order
+    std::vector<int> first_source(nbin+1, 0);
+    for (unsigned int i=0 ; i<nsource ; i++)
+        first_source[source_bin[i]+1]++;
+    for (int ibin=0 ; ibin<nbin ; ibin++)
+        first_source[ibin+1] += first_source[ibin];
+
+    std::vector<unsigned int> source_order(nsource);
+    std::vector<int> next(first_source.begin(), first_source.end()-1);
+    for (unsigned int i=0 ; i<nsource ; i++)
+        source_order[next[source_bin[i]]++] = i;
+
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        splice_in_bins( *double_prop[iprop], *source_particles.double_prop[iprop], source_order, first_source, nbin, bmin, bmax );
+
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        splice_in_bins( *short_prop[iprop], *source_particles.short_prop[iprop], source_order, first_source, nbin, bmin, bmax );
+
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        splice_in_bins( *uint64_prop[iprop], *source_particles.uint64_prop[iprop], source_order, first_source, nbin, bmin, bmax );
+
+    // Update the bin limits
+    for (int ibin=0 ; ibin<nbin ; ibin++) {
+        bmin[ibin] += first_source[ibin];
+        bmax[ibin] += first_source[ibin+1];
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Suppress npart particles from ipart
 // ---------------------------------------------------------------------------------------------------------------------
@@ -605,6 +708,277 @@ void Particles::create_particles(int nAdditionalParticles )
         (*uint64_prop[iprop]).resize(nParticles+nAdditionalParticles,0);
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Reserve the capacity of all the properties for nParticles
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::reserve_properties( unsigned int nParticles )
+{
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        (*double_prop[iprop]).reserve(nParticles);
+
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        (*short_prop[iprop]).reserve(nParticles);
+
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        (*uint64_prop[iprop]).reserve(nParticles);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Clear a buffer of created particles once imported in their species
+// The capacity is kept (and raised to capacity_hint, e.g. for a cloned patch), so that create_particle does not
+// reallocate in steady state
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::recycle()
+{
+    clear();
+    reserve_properties( capacity_hint );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Capacity policy with hysteresis, applied every every_clean_particles_overhead timesteps
+//   - peak = max(capacity_hint, size) : largest number of particles since the last call
+//   - the properties are reallocated only if their capacity exceeds high_watermark * peak, to low_watermark * peak,
+//     so that a structure whose size oscillates does not shrink and regrow at each call
+//   - capacity_hint then decays by the factor decay, a structure that stays smaller is shrunk at the next calls
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::manage_capacity( double high_watermark, double low_watermark, double decay )
+{
+    unsigned int peak = std::max( capacity_hint, size() );
+    capacity_hint = std::max( size(), (unsigned int)( decay * peak ) );
+
+    if ( double_prop.empty() || (double)Weight.capacity() <= high_watermark * peak ) return;
+
+    unsigned int new_capacity = std::max( size(), (unsigned int)( low_watermark * peak ) );
+
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        std::vector<double> resized;
+        resized.reserve( new_capacity );
+        resized.assign( double_prop[iprop]->begin(), double_prop[iprop]->end() );
+        resized.swap( *double_prop[iprop] );
+    }
+
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        std::vector<short> resized;
+        resized.reserve( new_capacity );
+        resized.assign( short_prop[iprop]->begin(), short_prop[iprop]->end() );
+        resized.swap( *short_prop[iprop] );
+    }
+
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        std::vector<uint64_t> resized;
+        resized.reserve( new_capacity );
+        resized.assign( uint64_prop[iprop]->begin(), uint64_prop[iprop]->end() );
+        resized.swap( *uint64_prop[iprop] );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Memory used by the particles (size of the properties)
+// ---------------------------------------------------------------------------------------------------------------------
+uint64_t Particles::usedMemory() const
+{
+    uint64_t mem = 0;
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        mem += double_prop[iprop]->size() * sizeof(double);
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        mem += short_prop[iprop]->size() * sizeof(short);
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        mem += uint64_prop[iprop]->size() * sizeof(uint64_t);
+    return mem;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Memory reserved for the particles (capacity of the properties)
+// ---------------------------------------------------------------------------------------------------------------------
+uint64_t Particles::reservedMemory() const
+{
+    uint64_t mem = 0;
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        mem += double_prop[iprop]->capacity() * sizeof(double);
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        mem += short_prop[iprop]->capacity() * sizeof(short);
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        mem += uint64_prop[iprop]->capacity() * sizeof(uint64_t);
+    return mem;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Packed particles, sent as a single contiguous message of bytes
+// ---------------------------------------------------------------------------------------------------------------------
+size_t Particles::packedSize( unsigned int nParticles ) const
+{
+    return packed_header_size + (size_t)nParticles * ( double_prop.size() * sizeof(double)
+                                                     + uint64_prop.size() * sizeof(uint64_t)
+                                                     + short_prop .size() * sizeof(short) );
+}
+
+// Write the header of nParticles packed particles, return the beginning of the properties
+static char * write_packed_header( const Particles &particles, unsigned int nParticles, PackedParticles &buffer )
+{
+    buffer.resize( particles.packedSize(nParticles) );
+    uint32_t header[6] = { Particles::packed_layout_version, nParticles,
+                           (uint32_t)particles.double_prop.size(), (uint32_t)particles.short_prop.size(),
+                           (uint32_t)particles.uint64_prop.size(), 0 };
+    memcpy( &buffer[0], header, Particles::packed_header_size );
+    return &buffer[0] + Particles::packed_header_size;
+}
+
+// Gather the values prop[indexes[i]] at p, return the end of the packed values
+template <typename T>
+static char * pack_property( const std::vector<T> &prop, const std::vector<int> &indexes, char *p )
+{
+    T * packed = reinterpret_cast<T*>( p );
+    for ( unsigned int i=0 ; i<indexes.size() ; i++ )
+        packed[i] = prop[indexes[i]];
+    return p + indexes.size() * sizeof(T);
+}
+
+void Particles::pack( const std::vector<int> &indexes, PackedParticles &buffer ) const
+{
+    char * p = write_packed_header( *this, indexes.size(), buffer );
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        p = pack_property( *double_prop[iprop], indexes, p );
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        p = pack_property( *uint64_prop[iprop], indexes, p );
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        p = pack_property( *short_prop[iprop], indexes, p );
+}
+
+void Particles::pack( unsigned int iPart, unsigned int nParticles, PackedParticles &buffer ) const
+{
+    char * p = write_packed_header( *this, nParticles, buffer );
+    if ( nParticles == 0 )
+        return;
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        memcpy( p, &(*double_prop[iprop])[iPart], nParticles*sizeof(double) );
+        p += nParticles*sizeof(double);
+    }
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        memcpy( p, &(*uint64_prop[iprop])[iPart], nParticles*sizeof(uint64_t) );
+        p += nParticles*sizeof(uint64_t);
+    }
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        memcpy( p, &(*short_prop[iprop])[iPart], nParticles*sizeof(short) );
+        p += nParticles*sizeof(short);
+    }
+}
+
+// Read and check the header of packed particles
+static void read_packed_header( const Particles &particles, const PackedParticles &buffer, uint32_t header[6] )
+{
+    memcpy( header, &buffer[0], Particles::packed_header_size );
+    if ( header[0] != Particles::packed_layout_version )
+        ERROR( "Packed particles of layout version " << header[0] << " instead of " << Particles::packed_layout_version );
+    if ( header[2] != particles.double_prop.size() || header[3] != particles.short_prop.size() || header[4] != particles.uint64_prop.size() )
+        ERROR( "Packed particles do not have the same properties as the destination" );
+}
+
+unsigned int Particles::unpack( const PackedParticles &buffer, unsigned int dest_id )
+{
+    uint32_t header[6];
+    read_packed_header( *this, buffer, header );
+    unsigned int nParticles = header[1];
+    if ( dest_id + nParticles > size() )
+        ERROR( "Not enough room to unpack " << nParticles << " particles at " << dest_id );
+    if ( nParticles == 0 )
+        return 0;
+
+    const char * p = &buffer[0] + packed_header_size;
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        memcpy( &(*double_prop[iprop])[dest_id], p, nParticles*sizeof(double) );
+        p += nParticles*sizeof(double);
+    }
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        memcpy( &(*uint64_prop[iprop])[dest_id], p, nParticles*sizeof(uint64_t) );
+        p += nParticles*sizeof(uint64_t);
+    }
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        memcpy( &(*short_prop[iprop])[dest_id], p, nParticles*sizeof(short) );
+        p += nParticles*sizeof(short);
+    }
+    return nParticles;
+}
+
+void Particles::unpack_particle( const PackedParticles &buffer, unsigned int iPart, unsigned int dest_id )
+{
+    uint32_t header[6];
+    read_packed_header( *this, buffer, header );
+    unsigned int nParticles = header[1];
+
+    const char * p = &buffer[0] + packed_header_size;
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        memcpy( &(*double_prop[iprop])[dest_id], p + iPart*sizeof(double), sizeof(double) );
+        p += nParticles*sizeof(double);
+    }
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        memcpy( &(*uint64_prop[iprop])[dest_id], p + iPart*sizeof(uint64_t), sizeof(uint64_t) );
+        p += nParticles*sizeof(uint64_t);
+    }
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        memcpy( &(*short_prop[iprop])[dest_id], p + iPart*sizeof(short), sizeof(short) );
+        p += nParticles*sizeof(short);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Buffer of packed particles
+// ---------------------------------------------------------------------------------------------------------------------
+void PackedParticles::resize( size_t nbytes )
+{
+    std::vector<char>::resize( nbytes );
+    capacity_hint = std::max( capacity_hint, nbytes );
+}
+
+unsigned int PackedParticles::nParticles() const
+{
+    if ( size() < Particles::packed_header_size )
+        return 0;
+    uint32_t header[6];
+    memcpy( header, data(), Particles::packed_header_size );
+    return header[1];
+}
+
+// The positions are the first properties of the particles (see Particles::initialize)
+double PackedParticles::position( unsigned int idim, unsigned int iPart ) const
+{
+    double x;
+    memcpy( &x, data() + Particles::packed_header_size + ( (size_t)idim*nParticles() + iPart )*sizeof(double), sizeof(double) );
+    return x;
+}
+
+// Each property is shifted in place, the next ones by one more element than the previous ones
+void PackedParticles::erase_particle( unsigned int iPart )
+{
+    uint32_t header[6];
+    memcpy( header, data(), Particles::packed_header_size );
+    size_t nParticles = header[1];
+    size_t src = Particles::packed_header_size, dst = Particles::packed_header_size;
+    for ( unsigned int iprop=0 ; iprop<header[2]+header[4]+header[3] ; iprop++ ) {
+        size_t s = ( iprop < header[2] ) ? sizeof(double) : ( iprop < header[2]+header[4] ) ? sizeof(uint64_t) : sizeof(short);
+        memmove( data()+dst, data()+src, iPart*s );
+        memmove( data()+dst+iPart*s, data()+src+(iPart+1)*s, (nParticles-iPart-1)*s );
+        src += nParticles*s;
+        dst += (nParticles-1)*s;
+    }
+    header[1]--;
+    memcpy( data(), header, Particles::packed_header_size );
+    std::vector<char>::resize( dst );
+}
+
+// Same policy as Particles::manage_capacity
+void PackedParticles::manage_capacity( double high_watermark, double low_watermark, double decay )
+{
+    size_t peak = std::max( capacity_hint, size() );
+    capacity_hint = std::max( size(), (size_t)( decay * peak ) );
+
+    if ( (double)capacity() <= high_watermark * peak ) return;
+
+    std::vector<char> resized;
+    resized.reserve( std::max( size(), (size_t)( low_watermark * peak ) ) );
+    resized.assign( begin(), end() );
+    swap( resized );
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Create nParticles new particles at the end of vectors
 // ---------------------------------------------------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 #include "TimeSelection.h"
 
 class Particle;
+class PackedParticles;
 
 class Params;
 class Patch;
@@ -81,6 +82,12 @@ public:
     //! Suppress all particles from iPart to the end of particle array
     void erase_particle_trail(unsigned int iPart );
 
+    //! Suppress the particles of bin ibin with a null weight, and shift the following bins
+    void erase_null_weight( int ibin, int nbin, int * bmin, int * bmax );
+
+    //! Insert all the particles of source_particles at the end of their bin (source_bin) in one pass
+    void insert_particles_in_bins( Particles &source_particles, const std::vector<unsigned int> &source_bin, int nbin, int * bmin, int * bmax );
+
     //! Print parameters of particle iPart
     void print(unsigned int iPart);
 
@@ -118,6 +125,35 @@ public:
     //! Create nParticles new particles
     void create_particles(int nAdditionalParticles);
 
+    //! Reserve the capacity of all the properties for nParticles
+    void reserve_properties( unsigned int nParticles );
+    //! Clear a buffer of created particles, keeping the capacity needed at the next timesteps (capacity_hint)
+    void recycle();
+    //! Capacity policy with hysteresis : release the capacity only above high_watermark * capacity_hint,
+    //! down to low_watermark * capacity_hint, then decay capacity_hint
+    void manage_capacity( double high_watermark, double low_watermark, double decay );
+
+    //! Layout of packed particles : header of packed_header_size bytes (layout version, number of particles,
+    //! numbers of double, short and uint64 properties), then each property of all the particles contiguously,
+    //! doubles first, then uint64 and shorts
+    static const uint32_t packed_layout_version = 1;
+    static const size_t packed_header_size = 6*sizeof(uint32_t);
+    //! Size in bytes of nParticles packed particles
+    size_t packedSize( unsigned int nParticles ) const;
+    //! Pack the particles indexes[i] in a contiguous buffer (resized, its capacity is kept from one call to the next)
+    void pack( const std::vector<int> &indexes, PackedParticles &buffer ) const;
+    //! Pack nParticles particles starting at iPart in a contiguous buffer
+    void pack( unsigned int iPart, unsigned int nParticles, PackedParticles &buffer ) const;
+    //! Unpack a buffer of packed particles at dest_id, the particles must already exist, returns their number
+    unsigned int unpack( const PackedParticles &buffer, unsigned int dest_id );
+    //! Unpack the packed particle iPart of buffer at dest_id, the particle must already exist
+    void unpack_particle( const PackedParticles &buffer, unsigned int iPart, unsigned int dest_id );
+
+    //! Memory used by the particles (size of the properties)
+    uint64_t usedMemory() const;
+    //! Memory reserved for the particles (capacity of the properties)
+    uint64_t reservedMemory() const;
+
     //! Test if ipart is in the local patch
     bool is_part_in_domain(unsigned int ipart, Patch* patch);
 
@@ -237,6 +273,10 @@ public:
     //! True if tracking the particles
     bool tracked;
 
+    //! Number of particles expected in this structure : peak number of particles since the last call
+    //! to manage_capacity, decaying exponentially from one call to the next
+    unsigned int capacity_hint;
+
     void resetIds() {
         unsigned int s = Id.size();
         for (unsigned int iPart=0; iPart<s; iPart++) Id[iPart] = 0;
@@ -334,5 +374,30 @@ private:
 };
 
 
+//----------------------------------------------------------------------------------------------------------------------
+//! Contiguous buffer of packed particles (Particles::pack). Received particles are read, and removed when forwarded to
+//! another neighbor, in the buffer itself, then unpacked in their species
+//----------------------------------------------------------------------------------------------------------------------
+class PackedParticles : public std::vector<char> {
+public:
+    PackedParticles() : capacity_hint(0) {}
+
+    //! Resize the buffer to nbytes, keeping track of the peak size for the capacity policy
+    void resize( size_t nbytes );
+
+    //! Number of packed particles (0 for an empty buffer)
+    unsigned int nParticles() const;
+    //! Position idim of the packed particle iPart
+    double position( unsigned int idim, unsigned int iPart ) const;
+    //! Remove the packed particle iPart
+    void erase_particle( unsigned int iPart );
+
+    //! Capacity policy with hysteresis of Particles::manage_capacity, on the size in bytes
+    void manage_capacity( double high_watermark, double low_watermark, double decay );
+
+    //! Peak size in bytes since the last call to manage_capacity, decaying exponentially from one call to the next
+    size_t capacity_hint;
+};
+
 
 #endif
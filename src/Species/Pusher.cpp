@@ -1,6 +1,7 @@
 #include "Pusher.h"
 #include "Params.h"
 #include "Species.h"
+#include "Tools.h"
 
 Pusher::Pusher(Params& params, Species *species) :
     min_loc_vec(species->min_loc_vec) 
@@ -31,3 +32,8 @@ Pusher::Pusher(Params& params, Species *species) :
 Pusher::~Pusher()
 {
 }
+
+void Pusher::push_chunk(Particles &particles, int istart, int iend, int nchunk, double* Epart, double* Bpart, double* invgf)
+{
+    ERROR("Fused dynamics not available for this pusher");
+}
@@ -21,6 +21,9 @@ public:
     //! Overloading of () operator
     virtual void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread) = 0;
 
+    //! Push a chunk of particles, fields and invgf in buffers of size nchunk indexed from istart (fused dynamics)
+    virtual void push_chunk(Particles &particles, int istart, int iend, int nchunk, double* Epart, double* Bpart, double* invgf);
+
 protected:
     double dt, dts2;
     //! \todo Move mass_ in Particles_
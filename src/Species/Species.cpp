@@ -12,9 +12,11 @@
 #include <cstring>
 // IDRIS
 #include "PusherFactory.h"
+#include "DynamicsKernelFactory.h"
 #include "IonizationFactory.h"
 #include "RadiationFactory.h"
 #include "MultiphotonBreitWheelerFactory.h"
+#include "MergingFactory.h"
 #include "PartBoundCond.h"
 #include "PartWall.h"
 #include "BoundaryConditionType.h"
@@ -49,6 +51,11 @@ c_part_max(1),
 ionization_rate(Py_None),
 pusher("boris"),
 radiation_model("none"),
+merging_method("none"),
+merge_every(0),
+merge_min_particles_per_cell(16),
+merge_packet_size(4),
+merge_momentum_cell_size(3,16),
 time_frozen(0),
 radiating(false),
 relativistic_field_initialization(false),
@@ -63,6 +70,9 @@ temperatureProfile(3,NULL),
 ppcProfile(NULL),
 max_charge(0.),
 particles(&particles_sorted[0]),
+cell_sort_every(0),
+fused_dynamics(false),
+tiled_projection(false),
 position_initialization_array(NULL),
 momentum_initialization_array(NULL),
 n_numpy_particles(0),
@@ -80,7 +90,9 @@ cell_length(params.cell_length),
 min_loc_vec(patch->getDomainLocalMin()),
 tracking_diagnostic(10000),
 nDim_particle(params.nDim_particle),
+Merge(NULL),
 partBoundCond(NULL),
+dynamicsKernel(NULL),
 min_loc(patch->getDomainLocalMin(0))
 
 {
@@ -138,6 +150,7 @@ void Species::initCluster(Params& params)
     nrj_mw_lost = 0.;
     nrj_new_particles = 0.;
     nrj_radiation = 0.;
+    nb_merged = 0;
 
 }//END initCluster
 
@@ -170,21 +183,29 @@ void Species::initOperators(Params& params, Patch* patch)
         DEBUG("Species " << name << " will undergo multiphoton Breit-Wheeler!");
     }
 
+    // Create the macro-particle merging method
+    Merge = MergingFactory::create(params, this);
+    if (Merge) {
+        DEBUG("Species " << name << " will be merged!");
+    }
+
     // define limits for BC and functions applied and for domain decomposition
     partBoundCond = new PartBoundCond(params, this, patch);
 
+    // Statically dispatched kernel of the fused dynamics (if needed)
+    dynamicsKernel = DynamicsKernelFactory::create(params, this);
+
     for (unsigned int iDim=0 ; iDim < nDim_particle ; iDim++){
         for (unsigned int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             MPIbuff.partRecv[iDim][iNeighbor].initialize(0, (*particles));
-            MPIbuff.partSend[iDim][iNeighbor].initialize(0, (*particles));
             MPIbuff.part_index_send[iDim][iNeighbor].resize(0);
             MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
             MPIbuff.part_index_send_sz[iDim][iNeighbor] = 0;
         }
     }
-    typePartSend.resize(nDim_particle*2, MPI_DATATYPE_NULL);
-    typePartRecv.resize(nDim_particle*2, MPI_DATATYPE_NULL);
-    exchangePatch = MPI_DATATYPE_NULL;
+    for (unsigned int idir=0 ; idir < MPIbuff.direct_partRecv.size() ; idir++) {
+        MPIbuff.direct_partRecv[idir].initialize(0, (*particles));
+    }
 
 }
 
@@ -197,7 +218,9 @@ Species::~Species()
     if (Ionize) delete Ionize;
     if (Radiate) delete Radiate;
     if (Multiphoton_Breit_Wheeler_process) delete Multiphoton_Breit_Wheeler_process;
+    if (Merge) delete Merge;
     if (partBoundCond) delete partBoundCond;
+    if (dynamicsKernel) delete dynamicsKernel;
     if (ppcProfile) delete ppcProfile;
     if (chargeProfile) delete chargeProfile;
     if (densityProfile) delete densityProfile;
@@ -485,7 +508,7 @@ void Species::dynamics(double time_dual, unsigned int ispec,
                        Patch* patch, SmileiMPI* smpi,
                        RadiationTables & RadiationTables,
                        MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
-                       vector<Diagnostic*>& localDiags)
+                       vector<Diagnostic*>& localDiags, int bins)
 {
     int ithread, tid(0);
     #ifdef _OPENMP
@@ -496,8 +519,25 @@ void Species::dynamics(double time_dual, unsigned int ispec,
 
     unsigned int iPart;
 
+    // The bins can be pushed in two passes only if they are independent : the fused dynamics
+    // processes all the bins at once, and the decayed photons cleaning shifts the following bins
+    if ( fused_dynamics || Multiphoton_Breit_Wheeler_process || time_dual<=time_frozen ) {
+        if (bins == interior_bins)
+            return;
+        bins = all_bins;
+    }
+    unsigned int nbin = bmin.size();
+    unsigned int ibin_start(0), ibin_end(nbin), ibin_step(1);
+    if ( (bins == boundary_bins) && (nbin > 2) )
+        ibin_step = nbin-1;
+    else if (bins == interior_bins) {
+        ibin_start = 1;
+        ibin_end   = (nbin > 1) ? nbin-1 : 0;
+    }
+
     // Reset list of particles to exchange
-    clearExchList();
+    if (bins != interior_bins)
+        clearExchList();
 
     double ener_iPart(0.);
     std::vector<double> nrj_lost_per_thd(1, 0.);
@@ -507,13 +547,18 @@ void Species::dynamics(double time_dual, unsigned int ispec,
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
 
+        if (fused_dynamics) {
+            (*dynamicsKernel)(this, EMfields, Interp, Proj, params, diag_flag, partWalls, ispec);
+            return;
+        }
+
         smpi->dynamics_resize(ithread, nDim_particle, bmax.back());
 
         //Point to local thread dedicated buffers
         //Still needed for ionization
         vector<double> *Epart = &(smpi->dynamics_Epart[ithread]);
 
-        for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++) {
+        for (unsigned int ibin = ibin_start ; ibin < ibin_end ; ibin+=ibin_step) {
 
 
             // Interpolate the fields at the particle position
@@ -619,12 +664,14 @@ void Species::dynamics(double time_dual, unsigned int ispec,
 
             }
 
-            //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
-
              // Project currents if not a Test species and charges as well if a diag is needed.
              // Do not project if a photon
-             if ((!particles->is_test) && (mass > 0))
-                 (*Proj)(EMfields, *particles, smpi, bmin[ibin], bmax[ibin], ithread, ibin, clrw, diag_flag, params.is_spectral, b_dim, ispec );
+             if ((!particles->is_test) && (mass > 0)) {
+                 if (tiled_projection)
+                     Proj->project_tiles(EMfields, *particles, smpi, bmin[ibin], bmax[ibin], ithread, ibin, clrw, diag_flag, b_dim, ispec );
+                 else
+                     (*Proj)(EMfields, *particles, smpi, bmin[ibin], bmax[ibin], ithread, ibin, clrw, diag_flag, params.is_spectral, b_dim, ispec );
+             }
 
         }// ibin
 
@@ -681,6 +728,8 @@ void Species::dynamics(double time_dual, unsigned int ispec,
 
 }//END dynamic
 
+const int Species::fused_chunk_size;
+
 void Species::projection_for_diags(double time_dual, unsigned int ispec,
                        ElectroMagn* EMfields, 
                        Projector* Proj, Params &params, bool diag_flag,
@@ -866,16 +915,29 @@ void Species::sort_part(Params& params)
     shift[1] += MPIbuff.part_index_recv_sz[0][0];//Particles coming from ymin all go to bin 0 and shift all the other bins.
     shift[bmax.size()] += MPIbuff.part_index_recv_sz[0][1];//Used only to count the total number of particles arrived.
     //idim>0
+    //Particles received over MPI are read in their packed buffer (non-empty), the other ones in partRecv
     for (idim = 1; idim < ndim; idim++){
         for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
             n_part_recv = MPIbuff.part_index_recv_sz[idim][iNeighbor];
+            PackedParticles &packed = MPIbuff.partRecvBuffer[idim][iNeighbor];
             for (unsigned int j=0; j<(unsigned int)n_part_recv ;j++){
                 //We first evaluate how many particles arrive in each bin.
-                ii = int((MPIbuff.partRecv[idim][iNeighbor].position(0,j)-min_loc)/dbin);//bin in which the particle goes.
+                double x = packed.size() ? packed.position(0,j) : MPIbuff.partRecv[idim][iNeighbor].position(0,j);
+                ii = int((x-min_loc)/dbin);//bin in which the particle goes.
                 shift[ii+1]++; // It makes the next bins shift.
             }
         }
     }
+    //direct exchange
+    for (unsigned int idir = 0; idir < MPIbuff.direct_partRecv.size(); idir++){
+        n_part_recv = MPIbuff.direct_part_index_recv_sz[idir];
+        PackedParticles &packed = MPIbuff.direct_partRecvBuffer[idir];
+        for (unsigned int j=0; j<(unsigned int)n_part_recv ;j++){
+            double x = packed.size() ? packed.position(0,j) : MPIbuff.direct_partRecv[idir].position(0,j);
+            ii = int((x-min_loc)/dbin);
+            shift[ii+1]++;
+        }
+    }
 
 
     //Must be done sequentially
@@ -906,7 +968,10 @@ void Species::sort_part(Params& params)
         //if ( (neighbor_[0][iNeighbor]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
         if (                                               (n_part_recv!=0) ) {
             ii = iNeighbor*(bmax.size()-1);//0 if iNeighbor=0(particles coming from Xmin) and bmax.size()-1 otherwise.
-            MPIbuff.partRecv[0][iNeighbor].overwrite_part(0, *particles,bmax[ii],n_part_recv);
+            if (MPIbuff.partRecvBuffer[0][iNeighbor].size())
+                particles->unpack(MPIbuff.partRecvBuffer[0][iNeighbor], bmax[ii]);
+            else
+                MPIbuff.partRecv[0][iNeighbor].overwrite_part(0, *particles,bmax[ii],n_part_recv);
             bmax[ii] += n_part_recv ;
         }
     }
@@ -917,14 +982,35 @@ void Species::sort_part(Params& params)
             n_part_recv = MPIbuff.part_index_recv_sz[idim][iNeighbor];
             //if ( (neighbor_[idim][iNeighbor]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
             if (                                                  (n_part_recv!=0) ) {
+                PackedParticles &packed = MPIbuff.partRecvBuffer[idim][iNeighbor];
                 for(unsigned int j=0; j<(unsigned int)n_part_recv; j++){
-                    ii = int((MPIbuff.partRecv[idim][iNeighbor].position(0,j)-min_loc)/dbin);//bin in which the particle goes.
-                    MPIbuff.partRecv[idim][iNeighbor].overwrite_part(j, *particles,bmax[ii]);
+                    if (packed.size()) {
+                        ii = int((packed.position(0,j)-min_loc)/dbin);//bin in which the particle goes.
+                        particles->unpack_particle(packed, j, bmax[ii]);
+                    } else {
+                        ii = int((MPIbuff.partRecv[idim][iNeighbor].position(0,j)-min_loc)/dbin);
+                        MPIbuff.partRecv[idim][iNeighbor].overwrite_part(j, *particles,bmax[ii]);
+                    }
                     bmax[ii] ++ ;
                 }
             }
         }
     }
+    //direct exchange, particles can arrive in any bin as well
+    for (unsigned int idir = 0; idir < MPIbuff.direct_partRecv.size(); idir++){
+        n_part_recv = MPIbuff.direct_part_index_recv_sz[idir];
+        PackedParticles &packed = MPIbuff.direct_partRecvBuffer[idir];
+        for(unsigned int j=0; j<(unsigned int)n_part_recv; j++){
+            if (packed.size()) {
+                ii = int((packed.position(0,j)-min_loc)/dbin);
+                particles->unpack_particle(packed, j, bmax[ii]);
+            } else {
+                ii = int((MPIbuff.direct_partRecv[idir].position(0,j)-min_loc)/dbin);
+                MPIbuff.direct_partRecv[idir].overwrite_part(j, *particles,bmax[ii]);
+            }
+            bmax[ii] ++ ;
+        }
+    }
 
 
     //The width of one bin is cell_length[0] * clrw.
@@ -985,73 +1071,99 @@ void Species::sort_part(Params& params)
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Sort particles
+// Merge macro-particles bin by bin (see Merging), the removed particles are erased from their bin
+// Particles must be located in the patch (called after sort_part)
 // ---------------------------------------------------------------------------------------------------------------------
-void Species::count_sort_part(Params &params)
+void Species::merge_particles()
 {
-    unsigned int ip, npart, ixy,tot, oc, nxy, token;
-    int ix,iy;
-    double x,y;
-
-    nxy = params.n_space[0]*params.n_space[1];
-    token = (particles == &particles_sorted[0]);
-
-    int indices[nxy];
-    npart = particles->size();
-    //particles_sorted = particles ;
-    particles_sorted[token].initialize(npart, *particles);
-
-    for (unsigned int i=0; i < nxy ; i++) indices[i] = 0 ;
-
-    // first loop counts the # of particles in each cell
-    for (ip=0; ip < npart; ip++)
-        {
-            x = particles->position(0,ip)-min_loc;
-            y = particles->position(1,ip)-min_loc_vec[1];
-
-            ix = floor(x * dx_inv_[0]) ;
-            iy = floor(y * dx_inv_[1]) ;
-
-            ixy = iy + ix*params.n_space[1];
-
-
-            indices[ixy] ++;
+    for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++) {
+        unsigned int nremoved = (*Merge)(*particles, bmin[ibin], bmax[ibin]);
+        if (nremoved > 0) {
+            particles->erase_null_weight(ibin, bmin.size(), &bmin[0], &bmax[0]);
+            nb_merged += nremoved;
         }
+    }
+}
 
-    // second loop convert the count array in cumulative sum
-    tot=0;
-    for (unsigned int ixy=0; ixy < nxy; ixy++)
-        {
-            oc = indices[ixy];
-            indices[ixy] = tot;
-            tot += oc;
+// ---------------------------------------------------------------------------------------------------------------------
+// Sort particles cell by cell with a counting sort
+//   - x is the slowest index of the cell key so that the particle bins (clrw columns along x) are preserved
+//   - cell_keys of the sorted particles are kept up to date
+//   - sorted particles are written in the other buffer of particles_sorted, which becomes the current one
+// Particles must be located in the patch (called after sort_part)
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::count_sort_part(Params &params)
+{
+    unsigned int npart = particles->size();
+    if (npart==0) return;
+
+    int nx = params.n_space[0];
+    int ny = (nDim_field>1) ? params.n_space[1] : 1;
+    int nz = (nDim_field>2) ? params.n_space[2] : 1;
+    unsigned int ncells = nx*ny*nz;
+
+    // first loop computes the cell key of each particle
+    particles->cell_keys.resize(npart);
+    int *cell_keys = &(particles->cell_keys[0]);
+    for (unsigned int ip=0; ip < npart; ip++) {
+        int ix = (int)( (particles->position(0,ip)-min_loc) * dx_inv_[0] );
+        int key = min( max( ix, 0 ), nx-1 );
+        if (nDim_field>1) {
+            int iy = (int)( (particles->position(1,ip)-min_loc_vec[1]) * dx_inv_[1] );
+            key = key*ny + min( max( iy, 0 ), ny-1 );
+            if (nDim_field>2) {
+                int iz = (int)( (particles->position(2,ip)-min_loc_vec[2]) * dx_inv_[2] );
+                key = key*nz + min( max( iz, 0 ), nz-1 );
+            }
         }
+        cell_keys[ip] = key;
+    }
 
-    //Bookmarking is not needed if normal sort is called before.
-    //bmin[0] = 0;
-    //for (bin=0; bin<bmin.size()-1; bin++) { //Loop on the bins.
-    //
-    //    bmin[bin+1] = indices[(bin+1)*params.n_space[1]*clrw] ;
-    //    bmax[bin] = bmin[bin+1];
-    //}
-    //bin = bmin.size()-1 ;
-    //bmax[bin] = npart;
-
-    // last loop puts the particles and update the count array
-    for (ip=0; ip < npart; ip++) {
-        x = particles->position(0,ip)-min_loc;
-        y = particles->position(1,ip)-min_loc_vec[1];
+    // second loop counts the # of particles in each cell and converts the count array in cumulative sum
+    cell_start.assign(ncells+1, 0);
+    for (unsigned int ip=0; ip < npart; ip++)
+        cell_start[cell_keys[ip]+1]++;
+    for (unsigned int icell=0; icell < ncells; icell++)
+        cell_start[icell+1] += cell_start[icell];
+
+    // Bins are made of clrw full columns of cells along x
+    unsigned int bin_cells = clrw*ny*nz;
+    for (unsigned int ibin=0; ibin < bmin.size(); ibin++) {
+        bmin[ibin] = cell_start[ ibin   *bin_cells];
+        bmax[ibin] = cell_start[(ibin+1)*bin_cells];
+    }
 
-        ix = floor(x * dx_inv_[1]) ;
-        iy = floor(y * dx_inv_[2]) ;
+    // third loop computes the new index of the particles and updates the count array
+    sorted_index.resize(npart);
+    for (unsigned int ip=0; ip < npart; ip++)
+        sorted_index[ip] = cell_start[cell_keys[ip]]++;
 
-        ixy = iy + ix*params.n_space[1];
+    // Scatter the particles, property by property, in the other buffer
+    Particles &sorted = particles_sorted[ particles == &particles_sorted[0] ];
+    sorted.initialize(npart, *particles);
 
-        particles->overwrite_part(ip, particles_sorted[token] , indices[ixy]);
-        indices[ixy]++;
+    for (unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++) {
+        double *src = &( (*particles->double_prop[iprop])[0] );
+        double *dst = &( (*sorted.double_prop[iprop])[0] );
+        for (unsigned int ip=0; ip < npart; ip++)
+            dst[sorted_index[ip]] = src[ip];
+    }
+    for (unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++) {
+        short *src = &( (*particles->short_prop[iprop])[0] );
+        short *dst = &( (*sorted.short_prop[iprop])[0] );
+        for (unsigned int ip=0; ip < npart; ip++)
+            dst[sorted_index[ip]] = src[ip];
     }
+    for (unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++) {
+        uint64_t *src = &( (*particles->uint64_prop[iprop])[0] );
+        uint64_t *dst = &( (*sorted.uint64_prop[iprop])[0] );
+        for (unsigned int ip=0; ip < npart; ip++)
+            dst[sorted_index[ip]] = src[ip];
+    }
+    for (unsigned int ip=0; ip < npart; ip++)
+        sorted.cell_keys[sorted_index[ip]] = cell_keys[ip];
 
-    particles = &particles_sorted[token] ;
+    particles = &sorted;
 
 }
 
@@ -1075,6 +1187,10 @@ int Species::createParticles(vector<unsigned int> n_space_to_create, Params& par
         }
     }
 
+    // Random stream of this patch, the global x index of its first cell distinguishes the successive positions of the
+    // moving window (without the ghost cells, so that the particles do not depend on the oversize)
+    Rand::setStream( patch->Hindex(), Rand::particle_init_stream + speciesNumber, patch->getCellStartingGlobalIndex(0) + params.oversize[0] );
+
     // Create the x,y,z maps where profiles will be evaluated
     vector<double> ijk(3);
     for (ijk[0]=0; ijk[0]<n_space_to_create[0]; ijk[0]++)
@@ -1362,30 +1478,78 @@ int Species::createParticles(vector<unsigned int> n_space_to_create, Params& par
 // Move all particles from another species to this one
 void Species::importParticles( Params& params, Patch* patch, Particles& source_particles, vector<Diagnostic*>& localDiags )
 {
-    unsigned int npart = source_particles.size(), ibin, ii, nbin=bmin.size();
+    unsigned int npart = source_particles.size(), nbin=bmin.size();
+    if (npart == 0) {
+        source_particles.recycle();
+        return;
+    }
+
     double inv_cell_length = 1./ params.cell_length[0];
 
     // If this species is tracked, set the particle IDs
     if( particles->tracked )
         dynamic_cast<DiagnosticTrack*>(localDiags[tracking_diagnostic])->setIDs( source_particles );
 
-    // Move particles
+    // Bin of each new particle
+    import_bin.resize(npart);
     for( unsigned int i=0; i<npart; i++ ) {
-        // Copy particle to the correct bin
-        ibin = source_particles.position(0,i)*inv_cell_length - ( patch->getCellStartingGlobalIndex(0) + params.oversize[0] );
+        unsigned int ibin = source_particles.position(0,i)*inv_cell_length - ( patch->getCellStartingGlobalIndex(0) + params.oversize[0] );
+        import_bin[i] = ibin / params.clrw;
+    }
 
-        ibin /= params.clrw;
-        source_particles.cp_particle(i, *particles, bmin[ibin] );
+    // Move particles at the end of their bin, all at once
+    particles->insert_particles_in_bins( source_particles, import_bin, nbin, &bmin[0], &bmax[0] );
 
-        // Update the bin counts
-        bmax[ibin]++;
-        for (ii=ibin+1; ii<nbin; ii++) {
-            bmin[ii]++;
-            bmax[ii]++;
-        }
+    // Keep the buffer for the particles created at the next timestep
+    source_particles.recycle();
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Memory used by the particles of the species, and reserved for them
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::getParticlesMemory( uint64_t &used, uint64_t &reserved )
+{
+    std::vector<Particles*> buffers;
+    buffers.push_back( &particles_sorted[0] );
+    buffers.push_back( &particles_sorted[1] );
+    for (unsigned int iDim=0 ; iDim < MPIbuff.partRecv.size() ; iDim++) {
+        for (unsigned int iNeighbor=0 ; iNeighbor<MPIbuff.partRecv[iDim].size() ; iNeighbor++)
+            buffers.push_back( &MPIbuff.partRecv[iDim][iNeighbor] );
+    }
+    for (unsigned int idir=0 ; idir < MPIbuff.direct_partRecv.size() ; idir++)
+        buffers.push_back( &MPIbuff.direct_partRecv[idir] );
+    if (Ionize)
+        buffers.push_back( &Ionize->new_electrons );
+    if (Radiate)
+        buffers.push_back( &Radiate->new_photons );
+    if (Multiphoton_Breit_Wheeler_process)
+        for (int k=0; k<2; k++)
+            buffers.push_back( &Multiphoton_Breit_Wheeler_process->new_pair[k] );
+
+    used = 0;
+    reserved = 0;
+    for (unsigned int i=0 ; i<buffers.size() ; i++) {
+        used     += buffers[i]->usedMemory();
+        reserved += buffers[i]->reservedMemory();
     }
 
-    source_particles.clear();
+    // Packed particles exchanged with MPI neighbors
+    std::vector<PackedParticles*> packed;
+    for (unsigned int iDim=0 ; iDim < MPIbuff.partRecvBuffer.size() ; iDim++) {
+        for (unsigned int iNeighbor=0 ; iNeighbor<MPIbuff.partRecvBuffer[iDim].size() ; iNeighbor++) {
+            packed.push_back( &MPIbuff.partSendBuffer[iDim][iNeighbor] );
+            packed.push_back( &MPIbuff.partRecvBuffer[iDim][iNeighbor] );
+        }
+    }
+    for (unsigned int idir=0 ; idir < MPIbuff.direct_partRecvBuffer.size() ; idir++) {
+        packed.push_back( &MPIbuff.direct_partSendBuffer[idir] );
+        packed.push_back( &MPIbuff.direct_partRecvBuffer[idir] );
+    }
+    for (unsigned int i=0 ; i<packed.size() ; i++) {
+        used     += packed[i]->size();
+        reserved += packed[i]->capacity();
+    }
 }
 
 
@@ -18,6 +18,7 @@
 #include "RadiationTables.h"
 #include "MultiphotonBreitWheeler.h"
 #include "MultiphotonBreitWheelerTables.h"
+#include "Merging.h"
 
 class ElectroMagn;
 class Pusher;
@@ -25,10 +26,12 @@ class Interpolator;
 class Projector;
 class PartBoundCond;
 class PartWalls;
+class DynamicsKernel;
 class Field3D;
 class Patch;
 class SimWindow;
 class Radiation;
+class Merging;
 
 
 //! class Species
@@ -90,6 +93,17 @@ public:
     //! radiation model
     std::string radiation_model;
     
+    //! macro-particle merging method
+    std::string merging_method;
+    //! Number of timesteps between two merging operations (0 = never)
+    unsigned int merge_every;
+    //! Cells with less macro-particles than this are not merged
+    unsigned int merge_min_particles_per_cell;
+    //! Number of macro-particles merged at once into 2 macro-particles
+    unsigned int merge_packet_size;
+    //! Number of momentum cells in each direction for the merging
+    std::vector<unsigned int> merge_momentum_cell_size;
+    
     //! Time for which the species is frozen
     double time_frozen;
     
@@ -140,6 +154,19 @@ public:
     //! Vector containing all Particles of the considered Species
     Particles *particles;
     Particles particles_sorted[2];
+    //! Number of timesteps between two cell-level sorting of particles (0 = never)
+    unsigned int cell_sort_every;
+    //! Fused interpolation, push and projection chunk by chunk (see DynamicsKernel)
+    bool fused_dynamics;
+    //! Number of particles processed at once by the fused dynamics
+    static const int fused_chunk_size = 64;
+    //! Bins pushed by a call to dynamics : all of them, or the boundary bins (the only ones whose particles
+    //! can leave the patch along x during a timestep) and then the interior ones
+    static const int all_bins      = 0;
+    static const int boundary_bins = 1;
+    static const int interior_bins = 2;
+    //! Current deposition through local tiles, vectorized over particles (Projector::project_tiles)
+    bool tiled_projection;
     //std::vector<int> index_of_particles_to_exchange;
     
     //! Pointer toward position array
@@ -195,10 +222,8 @@ public:
     //! Oversize (copy from Params)
     std::vector<unsigned int> oversize;
     
-    //! MPI structure to exchange particles
-    std::vector<MPI_Datatype> typePartSend ;
-    std::vector<MPI_Datatype> typePartRecv ;
-    MPI_Datatype exchangePatch;
+    //! Packed particles of the species, sent when the patch moves to another MPI process
+    PackedParticles exchangePatch;
     
     //! Cell_length (copy from Params)
     std::vector<double> cell_length;
@@ -241,11 +266,17 @@ public:
     //! Multiphoton Breit-wheeler
     MultiphotonBreitWheeler * Multiphoton_Breit_Wheeler_process;
     
+    //! Macro-particle merging method
+    Merging * Merge;
+    
     //! Boundary condition for the Particles of the considered Species
     PartBoundCond* partBoundCond;
     
     //! Particles pusher (change momentum & change position)
     Pusher* Push;
+
+    //! Fused dynamics statically dispatched on the operators of the species (only if fused_dynamics)
+    DynamicsKernel* dynamicsKernel;
     
     
     // -----------------------------------------------------------------------------
@@ -282,7 +313,7 @@ public:
                           PartWalls* partWalls, Patch* patch, SmileiMPI* smpi,
                           RadiationTables &RadiationTables,
                           MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
-                          std::vector<Diagnostic*>& localDiags);
+                          std::vector<Diagnostic*>& localDiags, int bins);
 
     virtual void projection_for_diags(double time, unsigned int ispec,
                           ElectroMagn* EMfields,
@@ -314,7 +345,10 @@ public:
     
     //! Method used to sort particles
     virtual void sort_part(Params& param);
+    //! Method used to sort particles cell by cell, within their bins
     void count_sort_part(Params& param);
+    //! Method used to merge macro-particles, bin by bin
+    void merge_particles();
 
     //! 
     virtual void add_space_for_a_particle() {
@@ -358,12 +392,16 @@ public:
     //! Get energy gained via new particles
     double getNewParticlesNRJ() const {return mass*nrj_new_particles;}
     
+    //! Get the number of macro-particles removed by the merging
+    unsigned int getNbrOfMergedParticles() const {return nb_merged;}
+    
     //! Reinitialize the scalar diagnostics buffer
     void reinitDiags() {
         //nrj_bc_lost = 0;
         nrj_mw_lost = 0;
         nrj_new_particles = 0;
         //nrj_radiation = 0;
+        nb_merged = 0;
     }
     
     inline void storeNRJlost( double nrj ) { nrj_mw_lost += nrj; };
@@ -396,6 +434,10 @@ public:
         return speciesSize;
     }
     
+    //! Memory used by the particles of the species, and reserved for them
+    //! (particles, sorting and exchange buffers, buffers of created particles)
+    void getParticlesMemory( uint64_t &used, uint64_t &reserved );
+    
     //! Method to create new particles.
     int  createParticles(std::vector<unsigned int> n_space_to_create, Params& params, Patch * patch, int new_bin_idx);
     
@@ -422,6 +464,9 @@ protected:
 
     //! Accumulate nrj lost by the particle with the radiation
     double nrj_radiation;
+    
+    //! Accumulate the number of macro-particles removed by the merging
+    unsigned int nb_merged;
 
 private:
     //! Number of steps for Maxwell-Juettner cumulative function integration
@@ -441,6 +486,13 @@ private:
     //! Local minimum of MPI domain
     double min_loc;
 
+    //! Bin of each imported particle, used by importParticles
+    std::vector<unsigned int> import_bin;
+    //! Index of the first particle of each cell, used by count_sort_part
+    std::vector<int> cell_start;
+    //! New index of each particle, used by count_sort_part
+    std::vector<int> sorted_index;
+
     //! Samples npoints values of energies in a Maxwell-Juttner distribution
     std::vector<double> maxwellJuttner(unsigned int npoints, double temperature);
     //! Array used in the Maxwell-Juttner sampling (see doc)
@@ -381,6 +381,8 @@ public:
         PyTools::extract("c_part_max",thisSpecies->c_part_max,"Species",ispec);
 
         PyTools::extract("time_frozen",thisSpecies->time_frozen ,"Species",ispec);
+
+        PyTools::extract("cell_sort_every",thisSpecies->cell_sort_every ,"Species",ispec);
         if (thisSpecies->time_frozen > 0 && thisSpecies->momentum_initialization!="cold") {
             if ( patch->isMaster() ) WARNING("For species '" << species_name << "' possible conflict between time-frozen & not cold initialization");
         }
@@ -600,6 +602,50 @@ public:
             ERROR("For species '" << species_name << "' test & ionized is currently impossible");
         }
 
+        // Fused interpolation, push and projection
+        PyTools::extract("fused_dynamics", thisSpecies->fused_dynamics, "Species", ispec);
+        if (thisSpecies->fused_dynamics) {
+            if ( ( pusher != "boris" && pusher != "vay" && pusher != "higueracary" ) || params.vecto || params.interpolation_order != 2
+              || ( params.geometry != "2Dcartesian" && params.geometry != "3Dcartesian" ) || params.is_spectral
+              || thisSpecies->ionization_model != "none" || radiation_model != "none" || mass <= 0. )
+                ERROR("For species '" << species_name << "' fused_dynamics requires a massive species with the 'boris', 'vay' or 'higueracary' pusher, no ionization, no radiation, and a 2Dcartesian or 3Dcartesian geometry at interpolation_order 2 without vectorization or spectral solver");
+            if ( patch->isMaster() ) MESSAGE(2,"> Fused dynamics by chunks of " << Species::fused_chunk_size << " particles");
+        }
+
+        // Current deposition through local tiles
+        PyTools::extract("tiled_projection", thisSpecies->tiled_projection, "Species", ispec);
+        if (thisSpecies->tiled_projection) {
+            if ( params.vecto || params.interpolation_order != 2 || params.geometry != "3Dcartesian" || params.is_spectral || thisSpecies->fused_dynamics )
+                ERROR("For species '" << species_name << "' tiled_projection requires a 3Dcartesian geometry at interpolation_order 2, without vectorization, spectral solver or fused_dynamics");
+            if ( thisSpecies->cell_sort_every == 0 )
+                ERROR("For species '" << species_name << "' tiled_projection requires particles sorted by cell (cell_sort_every > 0)");
+        }
+
+        // Macro-particle merging
+        PyTools::extract("merging_method", thisSpecies->merging_method, "Species", ispec);
+        std::transform(thisSpecies->merging_method.begin(), thisSpecies->merging_method.end(), thisSpecies->merging_method.begin(), tolower);
+        if (thisSpecies->merging_method != "none") {
+            if (thisSpecies->merging_method != "vranic")
+                ERROR("For species '" << species_name << "' merging_method must be 'none' or 'vranic'");
+            PyTools::extract("merge_every", thisSpecies->merge_every, "Species", ispec);
+            PyTools::extract("merge_min_particles_per_cell", thisSpecies->merge_min_particles_per_cell, "Species", ispec);
+            PyTools::extract("merge_packet_size", thisSpecies->merge_packet_size, "Species", ispec);
+            if (!PyTools::extract("merge_momentum_cell_size", thisSpecies->merge_momentum_cell_size, "Species", ispec)
+             || thisSpecies->merge_momentum_cell_size.size() != 3)
+                ERROR("For species '" << species_name << "' merge_momentum_cell_size must be a list of 3 integers");
+            for (unsigned int i=0 ; i<3 ; i++)
+                if (thisSpecies->merge_momentum_cell_size[i] == 0)
+                    ERROR("For species '" << species_name << "' merge_momentum_cell_size must be positive");
+            if (thisSpecies->merge_packet_size < 3)
+                ERROR("For species '" << species_name << "' merge_packet_size must be at least 3");
+            if (thisSpecies->merge_min_particles_per_cell < thisSpecies->merge_packet_size)
+                ERROR("For species '" << species_name << "' merge_min_particles_per_cell must be at least merge_packet_size");
+            if (thisSpecies->particles->is_test)
+                ERROR("For species '" << species_name << "' test particles cannot be merged");
+            if (thisSpecies->merge_every > 0 && patch->isMaster())
+                MESSAGE(2,"> Macro-particle merging (" << thisSpecies->merging_method << ") every " << thisSpecies->merge_every << " timesteps");
+        }
+
         // Create the particles
         if (!params.restart) {
             // does a loop over all cells in the simulation
@@ -658,6 +704,14 @@ public:
         newSpecies->c_part_max                               = species->c_part_max;
         newSpecies->mass                                     = species->mass;
         newSpecies->time_frozen                              = species->time_frozen;
+        newSpecies->cell_sort_every                          = species->cell_sort_every;
+        newSpecies->fused_dynamics                           = species->fused_dynamics;
+        newSpecies->tiled_projection                         = species->tiled_projection;
+        newSpecies->merging_method                           = species->merging_method;
+        newSpecies->merge_every                              = species->merge_every;
+        newSpecies->merge_min_particles_per_cell             = species->merge_min_particles_per_cell;
+        newSpecies->merge_packet_size                        = species->merge_packet_size;
+        newSpecies->merge_momentum_cell_size                 = species->merge_momentum_cell_size;
         newSpecies->radiating                                = species->radiating;
         newSpecies->relativistic_field_initialization        = species->relativistic_field_initialization;
         newSpecies->time_relativistic_initialization         = species->time_relativistic_initialization;
@@ -921,6 +975,9 @@ public:
                 retSpecies[i]->electron_species = retSpecies[retSpecies[i]->electron_species_index];
                 retSpecies[i]->Ionize->new_electrons.tracked = retSpecies[i]->electron_species->particles->tracked;
                 retSpecies[i]->Ionize->new_electrons.initialize(0, params.nDim_particle );
+                // Start with the capacity learned by the cloned species
+                retSpecies[i]->Ionize->new_electrons.capacity_hint = vecSpecies[i]->Ionize->new_electrons.capacity_hint;
+                retSpecies[i]->Ionize->new_electrons.reserve_properties( retSpecies[i]->Ionize->new_electrons.capacity_hint );
             }
         }
 
@@ -938,6 +995,8 @@ public:
                     //retSpecies[i]->Radiate->new_photons.initialize(retSpecies[i]->getNbrOfParticles(),
                     //                                               params.nDim_particle );
                     retSpecies[i]->Radiate->new_photons.initialize(0,params.nDim_particle );
+                    retSpecies[i]->Radiate->new_photons.capacity_hint = vecSpecies[i]->Radiate->new_photons.capacity_hint;
+                    retSpecies[i]->Radiate->new_photons.reserve_properties( retSpecies[i]->Radiate->new_photons.capacity_hint );
                 }
                 else
                 {
@@ -961,6 +1020,10 @@ public:
                     retSpecies[i]->Multiphoton_Breit_Wheeler_process->new_pair[k].isMonteCarlo = retSpecies[i]->mBW_pair_species[k]->particles->isMonteCarlo;
                     retSpecies[i]->Multiphoton_Breit_Wheeler_process->new_pair[k].initialize(
                                         0,params.nDim_particle );
+                    retSpecies[i]->Multiphoton_Breit_Wheeler_process->new_pair[k].capacity_hint
+                        = vecSpecies[i]->Multiphoton_Breit_Wheeler_process->new_pair[k].capacity_hint;
+                    retSpecies[i]->Multiphoton_Breit_Wheeler_process->new_pair[k].reserve_properties(
+                                        retSpecies[i]->Multiphoton_Breit_Wheeler_process->new_pair[k].capacity_hint );
                 }
             }
             else
@@ -0,0 +1,176 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cmath>
+#include <cstdint>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class Random : counter-based random number generator (Philox4x32-10, Salmon et al., SC'11)
+//!
+//! A random number is a pure function of a key and of a counter :
+//!   - key     = ( seed, patch )
+//!   - counter = ( draw index [64 bits], stream id, timestep )
+//! A stream carries no shared state, it can be owned by a thread and replayed whatever the thread which processes
+//! the patch, results are then independent of the number of OpenMP threads and of the patch distribution.
+//! The batch versions draw one number per particle of a bin (field ionization, Niel radiation). The Monte-Carlo
+//! radiation, the multiphoton Breit-Wheeler process and the collisions draw their numbers one by one, when the
+//! events occur.
+//  --------------------------------------------------------------------------------------------------------------------
+class Random {
+public:
+    //! Random creator, stream (seed, 0, 0, 0)
+    Random( uint32_t seed = 0 ) : draw_(0), nbuffered_(0), has_normal_(false)
+    {
+        setStream( seed, 0, 0, 0 );
+    }
+
+    //! Select the stream (seed, patch, stream_id, timestep) and restart it from its first draw
+    inline void setStream( uint32_t seed, uint32_t patch, uint32_t stream_id, uint32_t timestep )
+    {
+        key_[0]    = seed;
+        key_[1]    = patch;
+        stream_id_ = stream_id;
+        timestep_  = timestep;
+        draw_      = 0;
+        nbuffered_ = 0;
+        has_normal_= false;
+    }
+
+    //! Uniform distribution in ]0,1[
+    inline double uniform()
+    {
+        if( nbuffered_ == 0 ) {
+            next( buffer_[0], buffer_[1] );
+            nbuffered_ = 2;
+        }
+        return buffer_[2 - nbuffered_--];
+    }
+
+    //! Uniform distribution in ]0,1-1e-11[
+    inline double uniform1()
+    {
+        return uniform() * ( 1.-1e-11 );
+    }
+
+    //! Uniform distribution in ]-1,1[
+    inline double uniform2()
+    {
+        return 2.*uniform() - 1.;
+    }
+
+    //! Normal distribution of standard deviation stddev (Box-Muller, the second value is kept for the next call)
+    inline double normal( double stddev )
+    {
+        if( has_normal_ ) {
+            has_normal_ = false;
+            return stddev * normal_;
+        }
+        double u1, u2;
+        next( u1, u2 );
+        double r     = std::sqrt( -2.*std::log( u1 ) );
+        double theta = 2.*M_PI*u2;
+        normal_      = r*std::sin( theta );
+        has_normal_  = true;
+        return stddev * r*std::cos( theta );
+    }
+
+    //! Fill out[0:n] with the uniform distribution in ]0,1[, one independent counter per pair of values
+    inline void uniform( double * out, unsigned int n )
+    {
+        uint64_t first = draw_;
+        unsigned int npairs = n/2;
+        #pragma omp simd
+        for( unsigned int i=0 ; i<npairs ; i++ ) {
+            double u1, u2;
+            generate( first+i, u1, u2 );
+            out[2*i  ] = u1;
+            out[2*i+1] = u2;
+        }
+        if( n%2 ) {
+            double u2;
+            generate( first+npairs, out[n-1], u2 );
+        }
+        draw_ += ( n+1 )/2;
+    }
+
+    //! Fill out[0:n] with the uniform distribution in ]-1,1[
+    inline void uniform2( double * out, unsigned int n )
+    {
+        uniform( out, n );
+        #pragma omp simd
+        for( unsigned int i=0 ; i<n ; i++ ) {
+            out[i] = 2.*out[i] - 1.;
+        }
+    }
+
+    //! Fill out[0:n] with the normal distribution of standard deviation stddev
+    inline void normal( double * out, unsigned int n, double stddev )
+    {
+        unsigned int npairs = n/2;
+        uniform( out, 2*npairs );
+        #pragma omp simd
+        for( unsigned int i=0 ; i<npairs ; i++ ) {
+            double r     = stddev * std::sqrt( -2.*std::log( out[2*i] ) );
+            double theta = 2.*M_PI*out[2*i+1];
+            out[2*i  ] = r*std::cos( theta );
+            out[2*i+1] = r*std::sin( theta );
+        }
+        if( n%2 ) {
+            out[n-1] = normal( stddev );
+        }
+    }
+
+private:
+    //! Compute the 2 uniform values associated to the draw index idraw of the current stream
+    inline void generate( uint64_t idraw, double & u1, double & u2 ) const
+    {
+        uint32_t ctr[4] = { ( uint32_t )( idraw ), ( uint32_t )( idraw >> 32 ), stream_id_, timestep_ };
+        uint32_t key[2] = { key_[0], key_[1] };
+        for( int iround=0 ; iround<10 ; iround++ ) {
+            uint64_t p0 = ( uint64_t )( 0xD2511F53u ) * ctr[0];
+            uint64_t p1 = ( uint64_t )( 0xCD9E8D57u ) * ctr[2];
+            uint32_t c0 = ( uint32_t )( p1 >> 32 ) ^ ctr[1] ^ key[0];
+            uint32_t c1 = ( uint32_t )( p1 );
+            uint32_t c2 = ( uint32_t )( p0 >> 32 ) ^ ctr[3] ^ key[1];
+            uint32_t c3 = ( uint32_t )( p0 );
+            ctr[0] = c0;
+            ctr[1] = c1;
+            ctr[2] = c2;
+            ctr[3] = c3;
+            key[0] += 0x9E3779B9u;
+            key[1] += 0xBB67AE85u;
+        }
+        u1 = toUniform( ( ( uint64_t )ctr[0] << 32 ) | ctr[1] );
+        u2 = toUniform( ( ( uint64_t )ctr[2] << 32 ) | ctr[3] );
+    }
+
+    //! Next draw of the stream
+    inline void next( double & u1, double & u2 )
+    {
+        generate( draw_, u1, u2 );
+        draw_++;
+    }
+
+    //! 53 upper bits of x mapped to the middle of the intervals of ]0,1[ (never 0, never 1)
+    static inline double toUniform( uint64_t x )
+    {
+        return ( ( double )( x >> 11 ) + 0.5 ) * ( 1.0/9007199254740992.0 );
+    }
+
+    //! Key of the generator : (seed, patch)
+    uint32_t key_[2];
+    //! Counter fields fixed for a stream
+    uint32_t stream_id_, timestep_;
+    //! Index of the next draw in the stream
+    uint64_t draw_;
+
+    //! Values of the last draw not yet consumed by uniform()
+    double buffer_[2];
+    unsigned int nbuffered_;
+
+    //! Second value of the last Box-Muller transform
+    double normal_;
+    bool has_normal_;
+};
+
+#endif
@@ -116,6 +116,13 @@ public:
     static bool file_exists(const std::string & filename) ;
     
     static std::string xyz;
+
+    //! Same as round() for the cell indexes (half away from zero), written with a truncation so that it vectorizes
+    static inline int round_index( double x ) {
+        int i = (int)x;
+        double r = x - (double)i;
+        return i + (r >= 0.5) - (r <= -0.5);
+    }
     
     //! Concatenate several strings
     template<class T1, class T2, class T3=std::string, class T4=std::string>
@@ -0,0 +1,46 @@
+import os, re, numpy as np, h5py
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+
+
+Ntot_ion = S.Scalar.Ntot_ion(timesteps=0).getData()[0]
+Validate("Initial number of ions", Ntot_ion )
+
+max_ubal = np.max( np.abs(S.Scalar.Ubal().getData()) )
+Validate("Max Ubal is below 2%", max_ubal<0.02 )
+
+# CONTENT OF THE DUMPS OF THE LAST RUN
+restart = sorted( [d for d in os.listdir(".") if d.startswith("restart")] )[-1]
+checkpoints = restart+"/checkpoints/"
+dumps = sorted( [f for f in os.listdir(checkpoints) if f.startswith("dump-")] )
+Validate("Dump numbers kept", sorted(set(d[5:10] for d in dumps)) )
+statics = [f for f in os.listdir(checkpoints) if f.startswith("static-")]
+Validate("One static file per process", len(statics) == len(set(d[11:] for d in dumps)) )
+
+# Links of each dump to the static file, by name relative to the dump directory
+linked = set()
+links_per_species = {}
+for dump in dumps:
+	with h5py.File(checkpoints+dump, "r") as f:
+		def visit(group):
+			for name in group:
+				link = group.get(name, getlink=True)
+				if isinstance(link, h5py.ExternalLink):
+					linked.add( (link.filename, link.path) )
+					species = re.sub(r"species-\d+-", "", name) if name.startswith("species-") else "fields"
+					links_per_species[species] = links_per_species.get(species, 0) + 1
+				elif isinstance(link, h5py.HardLink) and isinstance(group[name], h5py.Group):
+					visit(group[name])
+		visit(f)
+Validate("Dumps only link the static files", set(l[0] for l in linked) <= set(statics) )
+Validate("Number of links per species", links_per_species )
+
+# The static file holds exactly the objects that the kept dumps link
+in_static = set()
+for static in statics:
+	with h5py.File(checkpoints+static, "r") as f:
+		in_static.update( (static, name) for name in f )
+Validate("Static file holds only the linked objects", in_static == linked )
+Validate("Number of objects in the static file", len(in_static) )
@@ -0,0 +1,22 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+
+
+# NUMBER OF MACRO-PARTICLES
+Ntot = S.Scalar.Ntot_eon().getData()
+Validate("Initial number of electrons", Ntot[0] )
+Validate("Final number of electrons is at most half", Ntot[-1] <= 0.5*Ntot[0] )
+Nmrg = S.Scalar.Nmrg_eon().getData()
+Validate("Removed electrons are the merged ones", Ntot[0]-Ntot[-1] == np.sum(Nmrg) )
+Validate("Number of electrons", Ntot, 0.02*Ntot[0] )
+
+# CONSERVATIONS : the weight of each packet is conserved, and its energy
+weight = np.array( S.ParticleBinning(0).getData() ).flatten()
+Validate("Weight conserved", np.max(np.abs(weight/weight[0]-1.)) < 1e-12 )
+Ukin = S.Scalar.Ukin_eon().getData()
+Validate("Kinetic energy of the electrons", Ukin, 0.02*Ukin[0] )
+max_ubal = np.max( np.abs(S.Scalar.Ubal_norm().getData()) )
+Validate("Max Ubal_norm is below 1%", max_ubal<0.01 )
@@ -0,0 +1,16 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference is produced by the same namelist with fused_dynamics = False.
+# Per particle, the fused loop does the same operations as the separate operators, in the same
+# order: the results must be close to round-off.
+
+for scalar in ["Ntot_eon", "Ntot_ion", "Ukin_eon", "Ukin_ion", "Uelm", "Ubal"]:
+	data = np.array( S.Scalar(scalar).getData() )
+	Validate("Scalar "+scalar, data, 1e-6*np.max(np.abs(data)) )
+
+for field in ["Ex", "Ey", "Bz", "Rho_eon"]:
+	data = S.Field.Field0(field, timesteps=200).getData()[0]
+	Validate(field+" field at last timestep", data, 1e-6*np.max(np.abs(data)) )
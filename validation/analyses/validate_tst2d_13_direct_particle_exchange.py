@@ -0,0 +1,15 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference is produced by the same namelist with direct_particle_exchange = False, on 4 MPI processes.
+# The received particles are not stored in the same order, so that the currents are summed in a different
+# order : the energies differ by round-off errors growing with time.
+
+for species in ["eon", "ion"]:
+	Validate("Number of particles "+species, S.Scalar("Ntot_"+species).getData() )
+
+for scalar in ["Ukin_eon", "Ukin_ion", "Uelm"]:
+	data = np.array( S.Scalar(scalar).getData() )
+	Validate("Scalar "+scalar, data, 1e-3*np.max(np.abs(data)) )
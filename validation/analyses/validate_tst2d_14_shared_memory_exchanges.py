@@ -0,0 +1,10 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference is produced by the same namelist with aggregate_ghost_messages, shared_memory_exchanges
+# and field_arena set to False : the exchanges only move the ghost cells, the results must be identical.
+
+for scalar in ["Ubal", "Uelm", "Ukin", "Uelm_Ex", "Uelm_Ey", "Uelm_Bz_m"]:
+	Validate("Scalar "+scalar, S.Scalar(scalar).getData())
@@ -0,0 +1,13 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference is produced by the same namelist with single_exchange = False.
+# In 2D, each pass of the filter is the same stencil with both settings : the results must be identical.
+
+for scalar in ["Ukin_eon", "Uelm", "Ubal"]:
+	Validate("Scalar "+scalar, S.Scalar(scalar).getData() )
+
+for field in ["Ex", "Ey", "Bz", "Jx", "Jy"]:
+	Validate(field+" field at last timestep", S.Field.Field0(field, timesteps=160).getData()[0] )
@@ -0,0 +1,12 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference is produced with the loops of the Yee solvers before the cache blocks :
+# the operations are the same, the results must be identical.
+
+for field in ["Ex", "Ey", "Ez", "Bx", "By", "Bz"]:
+	data = S.Field.Field0(field, timesteps=60).getData()[0]
+	Validate(field+" field at last timestep, central plane", data[:,:,data.shape[2]//2] )
+	Validate(field+" field at last timestep, sum of squares", np.sum(data**2) )
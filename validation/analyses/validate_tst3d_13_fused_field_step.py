@@ -0,0 +1,15 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference is produced by the same namelist with fused_field_step = False :
+# the operations are the same, the results must be identical.
+
+for scalar in ["Ntot_eon", "Ukin_eon", "Uelm", "Ubal"]:
+	Validate("Scalar "+scalar, S.Scalar(scalar).getData() )
+
+for field in ["Ex", "Ey", "Ez", "Bx", "By", "Bz", "Jx", "Jy", "Rho_eon"]:
+	data = S.Field.Field0(field, timesteps=80).getData()[0]
+	Validate(field+" field at last timestep, central plane", data[:,:,data.shape[2]//2] )
+	Validate(field+" field at last timestep, sum of squares", np.sum(data**2) )
@@ -0,0 +1,16 @@
+import os, re, numpy as np, math 
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference is produced by the same namelist with tiled_projection = False (still sorted by cell).
+# The currents of a cell are summed in a different order : the results differ by round-off errors,
+# growing with time.
+
+for scalar in ["Ukin_eon", "Ukin_ion", "Uelm", "Ubal"]:
+	data = np.array( S.Scalar(scalar).getData() )
+	Validate("Scalar "+scalar, data, 1e-6*np.max(np.abs(data)) )
+
+for field in ["Jx", "Jy", "Jz", "Rho"]:
+	data = S.Field.Field0(field, timesteps=60).getData()[0]
+	Validate(field+" field at last timestep", data, 1e-4*np.max(np.abs(data)) )